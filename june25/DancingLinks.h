@@ -0,0 +1,215 @@
+#pragma once
+#include <vector>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include "GridState.h"
+#include "SearchStats.h"
+
+// Exact-cover engine (Knuth's Algorithm X with dancing links) for completing a tiling
+// Every empty cell is a primary column that must be covered exactly once. Each tile size is
+// a secondary column with a quota of remaining copies: choosing a row of that size uses one
+// copy, and once the quota reaches zero the column is covered, which hides every other row
+// of that size. A row is one placement of one size at one position over empty cells.
+// The links live in flat index arrays rather than heap-allocated nodes.
+template <int N>
+class DancingLinks {
+public:
+    static constexpr int SIDE = Partridge<N>::SIDE;
+
+    explicit DancingLinks(const BasicGridState<N>& state) {
+        // Column headers: 0 is the root, then one per empty cell, then one per tile size
+        std::vector<int> cell_column(SIDE * SIDE);
+        int columns = 1;
+        for (int y = 0; y < SIDE; ++y) {
+            for (int x = 0; x < SIDE; ++x) {
+                if (!state.occupied(x, y)) cell_column[y * SIDE + x] = columns++;
+            }
+        }
+        const int primary = columns - 1;
+        for (int k = 1; k <= N; ++k) size_column[k] = columns++;
+
+        for (int c = 0; c < columns; ++c) {
+            add_node(c, -1);
+            up[c] = down[c] = c;
+            left[c] = right[c] = c;
+        }
+        // Primary headers form the circular list the search picks columns from; secondary
+        // headers stay linked only to themselves
+        for (int c = 0; c <= primary; ++c) {
+            left[c] = c == 0 ? primary : c - 1;
+            right[c] = c == primary ? 0 : c + 1;
+        }
+        column_size.assign(columns, 0);
+        for (int k = 1; k <= N; ++k) quota[k] = state.remaining(k);
+
+        // One row per size and position that fits on the current board
+        for (int k = N; k >= 1; --k) {
+            if (quota[k] == 0) continue;
+            for (int y = 0; y + k <= SIDE; ++y) {
+                for (int x = 0; x + k <= SIDE; ++x) {
+                    if (!state.fits(k, x, y)) continue;
+                    const int first = int(column.size());
+                    const int row = int(row_placement.size());
+                    row_placement.push_back({int8_t(k), int8_t(x), int8_t(y)});
+                    for (int j = y; j < y + k; ++j) {
+                        for (int i = x; i < x + k; ++i) append_to_row(first, row, cell_column[j * SIDE + i]);
+                    }
+                    append_to_row(first, row, size_column[k]);
+                }
+            }
+        }
+    }
+
+    // Search for an exact cover; on success the chosen tiles are placed on state
+    // stats (ignored unless built with PARTRIDGE_STATS) counts search calls as nodes, chosen
+    // rows as placements tried and kept, the number of chosen rows as depth, and solutions
+    bool solve(BasicGridState<N>& state, const std::atomic<bool>* stop = nullptr, SearchStats* search_stats = nullptr) {
+        cancel = stop;
+        stats = STATS_ENABLED ? search_stats : nullptr;
+        cancelled = false;
+        chosen.clear();
+        if (!search()) return false;
+        for (int row : chosen) {
+            const auto& p = row_placement[row];
+            state.place_tile(p[0], p[1], p[2]);
+        }
+        return true;
+    }
+
+    int rows() const { return int(row_placement.size()); }
+    int nodes() const { return int(column.size()); }
+
+private:
+    std::vector<int> left, right, up, down, column, row_of; // one entry per node
+    std::vector<int> column_size;
+    std::vector<std::array<int8_t, 3>> row_placement; // {size, x, y} of each row
+    std::array<int, N + 1> size_column{};
+    std::array<int, N + 1> quota{}; // copies of each size still to be used
+    std::vector<int> chosen;
+    const std::atomic<bool>* cancel = nullptr;
+    SearchStats* stats = nullptr;
+    bool cancelled = false;
+    uint32_t visited = 0;
+
+    void add_node(int c, int row) {
+        left.push_back(0);
+        right.push_back(0);
+        up.push_back(0);
+        down.push_back(0);
+        column.push_back(c);
+        row_of.push_back(row);
+    }
+
+    // Append a node for column c to the row starting at node first, and to the bottom of c
+    void append_to_row(int first, int row, int c) {
+        const int n = int(column.size());
+        add_node(c, row);
+        up[n] = up[c];
+        down[n] = c;
+        down[up[c]] = n;
+        up[c] = n;
+        ++column_size[c];
+        if (n == first) {
+            left[n] = right[n] = n;
+        } else {
+            left[n] = left[first];
+            right[n] = first;
+            right[left[first]] = n;
+            left[first] = n;
+        }
+    }
+
+    void cover(int c) {
+        right[left[c]] = right[c];
+        left[right[c]] = left[c];
+        for (int i = down[c]; i != c; i = down[i]) {
+            for (int j = right[i]; j != i; j = right[j]) {
+                up[down[j]] = up[j];
+                down[up[j]] = down[j];
+                --column_size[column[j]];
+            }
+        }
+    }
+
+    void uncover(int c) {
+        for (int i = up[c]; i != c; i = up[i]) {
+            for (int j = left[i]; j != i; j = left[j]) {
+                ++column_size[column[j]];
+                up[down[j]] = j;
+                down[up[j]] = j;
+            }
+        }
+        right[left[c]] = c;
+        left[right[c]] = c;
+    }
+
+    bool is_size_column(int c) const { return c >= size_column[1]; }
+
+    // Cover a column of a chosen row: cells are covered outright, sizes use up one copy
+    void take(int c) {
+        if (!is_size_column(c)) {
+            cover(c);
+            return;
+        }
+        const int k = c - size_column[1] + 1;
+        if (--quota[k] == 0) cover(c);
+    }
+
+    void release(int c) {
+        if (!is_size_column(c)) {
+            uncover(c);
+            return;
+        }
+        const int k = c - size_column[1] + 1;
+        if (quota[k]++ == 0) uncover(c);
+    }
+
+    bool search() {
+        if (stats) {
+            const int depth = int(chosen.size());
+            ++stats->nodes;
+            if (depth > stats->max_depth) stats->max_depth = depth;
+            if ((stats->nodes & 0xFFFF) == 0) stats->heartbeat(depth);
+        }
+        if (right[0] == 0) { // every cell covered
+            if (stats) ++stats->solutions;
+            return true;
+        }
+        if (cancelled) return false;
+        if (cancel && (++visited & 1023) == 0 && cancel->load(std::memory_order_relaxed)) {
+            cancelled = true;
+            return false;
+        }
+
+        // Branch on the cell with the fewest candidate placements
+        int c = right[0];
+        for (int j = right[c]; j != 0; j = right[j]) {
+            if (column_size[j] < column_size[c]) c = j;
+        }
+        if (column_size[c] == 0) return false;
+
+        cover(c);
+        for (int r = down[c]; r != c; r = down[r]) {
+            chosen.push_back(row_of[r]);
+            if (stats) {
+                const int k = row_placement[row_of[r]][0];
+                ++stats->tried[k];
+                ++stats->placed[k];
+            }
+            for (int j = right[r]; j != r; j = right[j]) take(column[j]);
+            if (search()) return true;
+            for (int j = left[r]; j != r; j = left[j]) release(column[j]);
+            chosen.pop_back();
+        }
+        uncover(c);
+        return false;
+    }
+};
+
+// Solve with the dancing-links engine; on success state holds the completed tiling
+template <int N>
+bool solve_puzzle_dlx(BasicGridState<N>& state, const std::atomic<bool>* stop = nullptr, SearchStats* stats = nullptr) {
+    DancingLinks<N> dlx(state);
+    return dlx.solve(state, stop, stats);
+}
@@ -0,0 +1,427 @@
+#pragma once
+#include <vector>
+#include <array>
+#include <cstdint>
+#include <utility> // for pair
+#include <bitset>
+#include <algorithm> // for min
+#include <type_traits>
+
+// Bit helpers for the two row word types (64 bits for sides up to 63, 128 bits beyond)
+inline int count_trailing_zeros(uint64_t v) { return __builtin_ctzll(v); }
+inline int count_trailing_zeros(unsigned __int128 v) {
+    const uint64_t low = uint64_t(v);
+    return low ? __builtin_ctzll(low) : 64 + __builtin_ctzll(uint64_t(v >> 64));
+}
+inline int count_bits(uint64_t v) { return __builtin_popcountll(v); }
+inline int count_bits(unsigned __int128 v) { return __builtin_popcountll(uint64_t(v)) + __builtin_popcountll(uint64_t(v >> 64)); }
+inline int highest_bit(uint64_t v) { return 63 - __builtin_clzll(v); }
+inline int highest_bit(unsigned __int128 v) {
+    const uint64_t high = uint64_t(v >> 64);
+    return high ? 127 - __builtin_clzll(high) : 63 - __builtin_clzll(uint64_t(v));
+}
+
+// Geometry of a Partridge tiling of order N: k copies of the k x k tile for k = 1..N,
+// filling a square of side N(N+1)/2. Everything is constexpr so each order gets its own
+// fully specialised board code.
+template <int N>
+struct Partridge {
+    static constexpr int ORDER = N;
+    static constexpr int SIDE = N * (N + 1) / 2;
+    static constexpr int TILES = N * (N + 1) / 2; // 1 + 2 + ... + N tiles in a complete tiling
+
+    // One word per row, with room for the widths 0..SIDE in fillable_widths
+    using Row = std::conditional_t<(SIDE < 64), uint64_t, unsigned __int128>;
+    static constexpr int ROW_BITS = 8 * int(sizeof(Row));
+    static constexpr Row FULL_ROW = (Row(1) << SIDE) - 1; // all cells of a row occupied
+
+    // Precomputed row masks for each tile size: TILE_MASKS[k] has the low k bits set
+    static constexpr std::array<Row, N + 1> make_tile_masks() {
+        std::array<Row, N + 1> masks{};
+        for (int k = 1; k <= N; ++k) masks[k] = (Row(1) << k) - 1;
+        return masks;
+    }
+    static constexpr std::array<Row, N + 1> TILE_MASKS = make_tile_masks();
+};
+
+constexpr int MAX_POCKET = 256;   // empty components larger than this are not checked
+constexpr int MAX_POCKETS = 64;   // pockets tracked at once
+using AreaSums = std::bitset<MAX_POCKET + 1>;
+
+// Zobrist keys for hashing a board together with its remaining inventory
+// Each cell gets a random word; tile[k][y][x] is the XOR of the cell words under a k x k tile
+// at (x, y), so placing or removing a tile updates the hash with one XOR. inventory[k][c]
+// stands for "c copies of size k placed" (zero for c = 0), since different tile multisets
+// can cover the same cells.
+template <int N>
+struct ZobristKeys {
+    static constexpr int SIDE = Partridge<N>::SIDE;
+    std::vector<uint64_t> tile; // tile[(k * SIDE + y) * SIDE + x]
+    std::array<std::array<uint64_t, N + 1>, N + 1> inventory{};
+
+    ZobristKeys() : tile(size_t(N + 1) * SIDE * SIDE, 0) {
+        uint64_t seed = 0x9E3779B97F4A7C15ull * N;
+        auto next = [&seed]() { // splitmix64
+            uint64_t z = (seed += 0x9E3779B97F4A7C15ull);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            return z ^ (z >> 31);
+        };
+        std::vector<uint64_t> cell(SIDE * SIDE);
+        for (auto& key : cell) key = next();
+        for (int k = 1; k <= N; ++k) {
+            for (int c = 1; c <= k; ++c) inventory[k][c] = next();
+            for (int y = 0; y + k <= SIDE; ++y) {
+                for (int x = 0; x + k <= SIDE; ++x) {
+                    uint64_t key = 0;
+                    for (int j = y; j < y + k; ++j) {
+                        for (int i = x; i < x + k; ++i) key ^= cell[j * SIDE + i];
+                    }
+                    tile[(k * SIDE + y) * SIDE + x] = key;
+                }
+            }
+        }
+    }
+
+    // Hash change for placing or removing the copy that takes size k from c to c + 1 placed
+    uint64_t toggle(int k, int x, int y, int c) const {
+        return tile[(k * SIDE + y) * SIDE + x] ^ inventory[k][c] ^ inventory[k][c + 1];
+    }
+};
+
+template <int N>
+class BasicGridState {
+public:
+    using Geometry = Partridge<N>;
+    using Row = typename Geometry::Row;
+    static constexpr int ORDER = N;
+    static constexpr int SIDE = Geometry::SIDE;
+    static constexpr Row FULL_ROW = Geometry::FULL_ROW;
+
+    // An enclosed empty component: its cells (occupied ones drop out as tiles are placed inside it)
+    struct Pocket {
+        std::array<Row, SIDE> cells;
+        int8_t top, bottom; // rows spanned
+        int8_t max_size;    // largest tile that fits its bounding box
+        int owner;          // number of tiles on the board when it was found
+    };
+
+    std::array<Row, SIDE> rows{}; // bitboard: bit x of rows[y] set = cell (x, y) occupied
+    std::vector<std::vector<std::pair<int, int>>> tile_coords; // tile_coords[0] = 1x1 tiles, etc.
+    std::array<int8_t, SIDE> skyline{}; // skyline[x] = first row y such that (x, 0..y-1) are all occupied
+    std::vector<Pocket> pockets; // small enclosed empty components found so far
+    int placed = 0; // number of tiles on the board
+    uint64_t hash = 0; // Zobrist hash of the occupied cells and the tiles placed per size
+
+    static inline const ZobristKeys<N> zobrist{};
+
+    BasicGridState() : tile_coords(N) { // N vectors for 1x1 to NxN tiles
+        // Reserve room for every copy up front so placing tiles never allocates
+        for (int size = 1; size <= N; ++size) tile_coords[size - 1].reserve(size);
+        pockets.reserve(MAX_POCKETS);
+    }
+
+    // Is cell (x, y) occupied?
+    bool occupied(int x, int y) const { return (rows[y] >> x) & 1; }
+
+    // Does a tile of this size fit at (x, y)? (bounds and overlap only)
+    bool fits(int tile_size, int x, int y) const {
+        // Check if tile would go out of bounds
+        if (x + tile_size > SIDE || y + tile_size > SIDE) return false;
+
+        // Check for occupied cells in the tile area, one word per row
+        const Row mask = Geometry::TILE_MASKS[tile_size] << x;
+        for (int j = y; j < y + tile_size; ++j) {
+            if (rows[j] & mask) return false;
+        }
+        return true;
+    }
+
+    // Can a tile of this size be placed at (x, y)? (inventory, bounds and overlap)
+    bool can_place(int tile_size, int x, int y) const {
+        // Check if we've already placed all tiles of this size
+        if (int(tile_coords[tile_size - 1].size()) >= tile_size) return false;
+
+        return fits(tile_size, x, y);
+    }
+
+    // Function to place a tile
+    bool place_tile(int tile_size, int x, int y) {
+        if (!can_place(tile_size, x, y)) return false;
+
+        // Place tile
+        const Row mask = Geometry::TILE_MASKS[tile_size] << x;
+        for (int j = y; j < y + tile_size; ++j) rows[j] |= mask;
+
+        hash ^= zobrist.toggle(tile_size, x, y, int(tile_coords[tile_size - 1].size()));
+        tile_coords[tile_size - 1].emplace_back(x, y);
+        ++placed;
+
+        // Raise the skyline over the tile, then past any pre-placed tiles directly below it
+        for (int i = x; i < x + tile_size; ++i) {
+            if (skyline[i] != y) continue;
+            int top = y + tile_size;
+            while (top < SIDE && occupied(i, top)) ++top;
+            skyline[i] = int8_t(top);
+        }
+        return true;
+    }
+
+    // Function to remove the most recently placed tile of this size at (x, y)
+    void remove_tile(int tile_size, int x, int y) {
+        const Row mask = Geometry::TILE_MASKS[tile_size] << x;
+        for (int j = y; j < y + tile_size; ++j) rows[j] &= ~mask;
+
+        tile_coords[tile_size - 1].pop_back();
+        hash ^= zobrist.toggle(tile_size, x, y, int(tile_coords[tile_size - 1].size()));
+        --placed;
+        if (y < first_open_row) first_open_row = y;
+
+        // Forget pockets that were found after this tile was placed
+        while (!pockets.empty() && pockets.back().owner > placed) pockets.pop_back();
+
+        // Cells above the tile are still occupied, so the skyline drops back to its top edge
+        for (int i = x; i < x + tile_size; ++i) {
+            if (skyline[i] > y) skyline[i] = int8_t(y);
+        }
+    }
+
+    // Number of tiles of this size still to be placed
+    int remaining(int tile_size) const { return tile_size - int(tile_coords[tile_size - 1].size()); }
+
+    // Bit w is set if some of the remaining tiles no larger than max_size add up to width w
+    // (copies of each size are split into groups of 1, 2, 4, ... so each size costs a few shifts)
+    Row fillable_widths(int max_size) const {
+        Row sums = 1;
+        for (int k = 1; k <= max_size; ++k) {
+            int copies = remaining(k);
+            for (int group = 1; copies > 0; group *= 2) {
+                const int take = group < copies ? group : copies;
+                sums |= sums << (take * k);
+                copies -= take;
+            }
+        }
+        return sums;
+    }
+
+    // Skyline gap check for the skyline segment containing column x
+    // A valley is a maximal run of columns at the same skyline height v with higher columns
+    // (or the board edge) on both sides. The empty cells along its bottom can only be covered
+    // by tiles whose top edge is row v and which lie within the run, so its width must be a
+    // sum of remaining tile sizes that fit in the SIDE - v rows below.
+    bool segment_fillable(int x, Row widths) const {
+        const int v = skyline[x];
+        if (v >= SIDE) return true;
+
+        int start = x, end = x;
+        while (start > 0 && skyline[start - 1] == v) --start;
+        while (end < SIDE - 1 && skyline[end + 1] == v) ++end;
+        if ((start > 0 && skyline[start - 1] < v) || (end < SIDE - 1 && skyline[end + 1] < v)) return true; // not a valley
+
+        const Row fill = SIDE - v >= N ? widths : fillable_widths(SIDE - v);
+        return (fill >> (end - start + 1)) & 1;
+    }
+
+    // After placing a tile of this size at column x, can the valleys it borders still be filled?
+    bool frontier_feasible(int tile_size, int x) const {
+        const Row widths = fillable_widths(N);
+        const int right = x + tile_size;
+        return segment_fillable(x, widths) && segment_fillable(right - 1, widths)
+            && (x == 0 || segment_fillable(x - 1, widths))
+            && (right >= SIDE || segment_fillable(right, widths));
+    }
+
+    // Bit a is set if some of the remaining tiles no larger than max_size cover area a exactly
+    AreaSums fillable_areas(int max_size) const {
+        AreaSums sums;
+        sums[0] = true;
+        for (int k = 1; k <= max_size; ++k) {
+            int copies = remaining(k);
+            for (int group = 1; copies > 0; group *= 2) {
+                const int take = group < copies ? group : copies;
+                sums |= sums << (take * k * k);
+                copies -= take;
+            }
+        }
+        return sums;
+    }
+
+    // Flood-fill the empty component containing (x, y) into pocket, giving up (returning false)
+    // once it grows past max_area cells. Rows are filled a word at a time with occluded fills.
+    bool flood_pocket(int x, int y, Pocket& pocket, int max_area = MAX_POCKET) const {
+        auto& region = pocket.cells;
+        region.fill(0);
+        region[y] = Row(1) << x;
+        int top = y, bottom = y;
+        for (bool changed = true; changed;) {
+            changed = false;
+            int area = 0;
+            const int from = top > 0 ? top - 1 : 0, to = bottom < SIDE - 1 ? bottom + 1 : SIDE - 1;
+            for (int j = from; j <= to; ++j) {
+                const Row free = ~rows[j] & FULL_ROW;
+                Row r = region[j];
+                if (j > 0) r |= region[j - 1];
+                if (j < SIDE - 1) r |= region[j + 1];
+                r &= free;
+                // Spread along runs of free cells in both directions
+                Row left = free, right = free;
+                for (int shift = 1; shift < Geometry::ROW_BITS; shift *= 2) {
+                    r |= ((r << shift) & left) | ((r >> shift) & right);
+                    left &= left << shift;
+                    right &= right >> shift;
+                }
+                if (r != region[j]) {
+                    region[j] = r;
+                    changed = true;
+                }
+                if (r) {
+                    area += count_bits(r);
+                    if (j < top) top = j;
+                    if (j > bottom) bottom = j;
+                }
+            }
+            if (area > max_area) return false;
+        }
+
+        Row columns = 0;
+        for (int j = top; j <= bottom; ++j) columns |= region[j];
+        const int width = highest_bit(columns) - count_trailing_zeros(columns) + 1;
+        const int height = bottom - top + 1;
+        pocket.top = int8_t(top);
+        pocket.bottom = int8_t(bottom);
+        pocket.max_size = int8_t(std::min({width, height, N}));
+        pocket.owner = placed;
+        return true;
+    }
+
+    // Empty cells left in a pocket
+    int pocket_area(const Pocket& pocket) const {
+        int area = 0;
+        for (int j = pocket.top; j <= pocket.bottom; ++j) area += count_bits(pocket.cells[j] & ~rows[j]);
+        return area;
+    }
+
+    // Can the remaining tiles that fit in each tracked pocket still cover its area exactly?
+    bool pockets_fillable() const {
+        if (pockets.empty()) return true;
+        std::array<AreaSums, N + 1> sums;
+        int computed = 0; // bit k set once sums[k] is filled in
+        for (const Pocket& pocket : pockets) {
+            const int area = pocket_area(pocket);
+            if (area == 0) continue;
+            if (!(computed >> pocket.max_size & 1)) {
+                sums[pocket.max_size] = fillable_areas(pocket.max_size);
+                computed |= 1 << pocket.max_size;
+            }
+            if (!sums[pocket.max_size][area]) return false;
+        }
+        return true;
+    }
+
+    // Record the small component containing empty cell (x, y), unless a tracked pocket already holds it
+    void track_pocket(int x, int y) {
+        if (int(pockets.size()) >= MAX_POCKETS) return;
+        for (const Pocket& pocket : pockets) {
+            if (pocket.owner == placed && (pocket.cells[y] >> x & 1)) return;
+        }
+        Pocket pocket;
+        if (flood_pocket(x, y, pocket)) pockets.push_back(pocket);
+    }
+
+    // Pocket check after placing a tile of this size at (x, y)
+    // Walking the ring of cells around the tile, each run of empty cells is a piece of some
+    // component. If there are several runs the tile may have cut a component in two, so the
+    // component behind each run is flood-filled and tracked if it is small. Every tracked
+    // pocket is then checked against the remaining inventory.
+    bool check_pockets(int tile_size, int x, int y) {
+        // Ring cells clockwise from the top-left corner; off-board cells count as occupied
+        std::array<std::pair<int8_t, int8_t>, 4 * N + 4> ring;
+        std::array<bool, 4 * N + 4> free;
+        int length = 0;
+        auto add = [&](int cx, int cy) {
+            ring[length] = {int8_t(cx), int8_t(cy)};
+            free[length++] = cx >= 0 && cx < SIDE && cy >= 0 && cy < SIDE && !occupied(cx, cy);
+        };
+        for (int i = 0; i <= tile_size + 1; ++i) add(x - 1 + i, y - 1);         // top, both corners
+        for (int i = 0; i <= tile_size; ++i) add(x + tile_size, y + i);         // right, down to its corner
+        for (int i = 1; i <= tile_size; ++i) add(x + tile_size - i, y + tile_size); // bottom, right to left
+        for (int i = 0; i <= tile_size; ++i) add(x - 1, y + tile_size - i);     // left, up from its corner
+
+        int runs = 0;
+        for (int i = 0; i < length; ++i) runs += free[i] && !free[(i + length - 1) % length];
+        if (runs >= 2) {
+            for (int i = 0; i < length; ++i) {
+                if (free[i] && !free[(i + length - 1) % length]) track_pocket(ring[i].first, ring[i].second);
+            }
+        }
+        return pockets_fillable();
+    }
+
+    // Track every small component on the board in place of the pockets found so far (used on
+    // the initial tiling); the scan finds every component those pockets still hold
+    bool check_all_pockets() {
+        std::array<Row, SIDE> seen = rows;
+        Pocket pocket;
+        pockets.clear();
+        for (int y = 0; y < SIDE; ++y) {
+            while (seen[y] != FULL_ROW) {
+                const int x = count_trailing_zeros(Row(~seen[y]));
+                flood_pocket(x, y, pocket, SIDE * SIDE);
+                for (int j = pocket.top; j <= pocket.bottom; ++j) seen[j] |= pocket.cells[j];
+                if (pocket_area(pocket) <= MAX_POCKET && int(pockets.size()) < MAX_POCKETS) pockets.push_back(pocket);
+            }
+        }
+        return pockets_fillable();
+    }
+
+    // Function to find first empty cell (top-left to bottom-right)
+    std::pair<int, int> find_first_empty() const {
+        // Rows above first_open_row are known to be full, so skip them
+        for (int y = first_open_row; y < SIDE; ++y) {
+            if (rows[y] != FULL_ROW) {
+                first_open_row = y;
+                return {count_trailing_zeros(Row(~rows[y])), y};
+            }
+        }
+        first_open_row = SIDE;
+        return {-1, -1}; // no empty cell found
+    }
+
+    // Length of the run of empty cells starting at empty cell (x, y) and going right
+    int run_right(int x, int y) const {
+        const Row rest = rows[y] >> x;
+        return rest ? count_trailing_zeros(rest) : SIDE - x;
+    }
+
+    // Length of the run of empty cells starting at empty cell (x, y) and going down
+    int run_down(int x, int y) const {
+        int j = y;
+        while (j < SIDE && !occupied(x, j)) ++j;
+        return j - y;
+    }
+
+    // Number of empty cells left on the board
+    int empty_cells() const {
+        int filled = 0;
+        for (Row row : rows) filled += count_bits(row);
+        return SIDE * SIDE - filled;
+    }
+
+private:
+    mutable int first_open_row = 0; // lower bound on the first row with an empty cell
+};
+
+using GridState = BasicGridState<9>; // the 45x45 board of the puzzle
+
+using Tiling = std::vector<std::vector<std::pair<int, int>>>; // Tiling[i] = coordinates of the (i+1)x(i+1) tiles
+
+// Build an isolated board holding the pre-placed tiles of one instance
+inline GridState initial_state(const Tiling& initial_tiling) {
+    GridState state;
+    for (int i = 0; i < int(initial_tiling.size()); ++i) {
+        for (const auto& coord : initial_tiling[i]) {
+            state.place_tile(i + 1, coord.first, coord.second);
+        }
+    }
+    return state;
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string>
+#include "GridState.h"
+
+// Value orderings: the order in which the backtracker tries tile sizes at an empty cell
+// largest: N down to 1, whatever the inventory or the room at the cell (the original order)
+// fits:    largest first, but only sizes with copies left that fit the empty runs right and down
+// fewest:  the sizes that fit, fewest remaining copies first (largest first on ties)
+// gap:     the sizes that fit, first the one that closes the empty run to the right exactly, then
+//          those leaving a rest of the run that one remaining tile closes, then the others
+//          (largest first within each group)
+enum class Ordering { Largest, LargestFits, FewestCopies, GapAware };
+
+constexpr Ordering ALL_ORDERINGS[] = {Ordering::Largest, Ordering::LargestFits, Ordering::FewestCopies, Ordering::GapAware};
+
+// Parse an ordering name; returns false if it is not recognised
+inline bool parse_ordering(const std::string& name, Ordering& ordering) {
+    if (name == "largest") ordering = Ordering::Largest;
+    else if (name == "fits") ordering = Ordering::LargestFits;
+    else if (name == "fewest") ordering = Ordering::FewestCopies;
+    else if (name == "gap") ordering = Ordering::GapAware;
+    else return false;
+    return true;
+}
+
+inline const char* ordering_name(Ordering ordering) {
+    switch (ordering) {
+        case Ordering::LargestFits: return "fits";
+        case Ordering::FewestCopies: return "fewest";
+        case Ordering::GapAware: return "gap";
+        case Ordering::Largest: break;
+    }
+    return "largest";
+}
+
+// Fill sizes with the tile sizes to try at empty cell (x, y), in order; returns how many
+template <int N>
+int order_sizes(const BasicGridState<N>& state, Ordering ordering, int x, int y, std::array<int8_t, size_t(N)>& sizes) {
+    int count = 0;
+    if (ordering == Ordering::Largest) {
+        for (int k = N; k >= 1; --k) sizes[count++] = int8_t(k);
+        return count;
+    }
+
+    const int width = state.run_right(x, y);
+    const int height = state.run_down(x, y);
+    const int room = width < height ? width : height;
+    for (int k = (room < N ? room : N); k >= 1; --k) {
+        if (state.remaining(k) > 0) sizes[count++] = int8_t(k);
+    }
+
+    // Stable insertion sort of the largest-first list by the ordering's key
+    auto key = [&](int k) {
+        if (ordering == Ordering::FewestCopies) return state.remaining(k);
+        if (ordering == Ordering::GapAware) {
+            const int rest = width - k;
+            if (rest == 0) return 0;
+            return rest <= N && state.remaining(rest) > (rest == k) ? 1 : 2;
+        }
+        return 0;
+    };
+    for (int i = 1; i < count; ++i) {
+        const int8_t k = sizes[i];
+        const int k_key = key(k);
+        int j = i;
+        for (; j > 0 && key(sizes[j - 1]) > k_key; --j) sizes[j] = sizes[j - 1];
+        sizes[j] = k;
+    }
+    return count;
+}
@@ -0,0 +1,119 @@
+#pragma once
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include "GridState.h"
+#include "Solver.h"
+
+// Board symmetries, as three bits applied to each tile in turn: 4 = transpose (swap x and y),
+// then 1 = mirror left-right, then 2 = mirror top-bottom. Searching a transposed board with
+// the row-major first-empty scan is the same as scanning the original board column by column.
+inline const char* symmetry_name(int symmetry) {
+    static const char* names[] = {"identity", "mirror", "flip", "rotate180", "transpose", "rotate90", "rotate270", "antitranspose"};
+    return names[symmetry];
+}
+
+// Top-left corner of a k x k tile at (x, y) after the symmetry
+template <int N>
+std::pair<int, int> map_tile(int symmetry, int k, int x, int y) {
+    constexpr int SIDE = Partridge<N>::SIDE;
+    if (symmetry & 4) std::swap(x, y);
+    if (symmetry & 1) x = SIDE - x - k;
+    if (symmetry & 2) y = SIDE - y - k;
+    return {x, y};
+}
+
+// Inverse of map_tile
+template <int N>
+std::pair<int, int> unmap_tile(int symmetry, int k, int x, int y) {
+    constexpr int SIDE = Partridge<N>::SIDE;
+    if (symmetry & 1) x = SIDE - x - k;
+    if (symmetry & 2) y = SIDE - y - k;
+    if (symmetry & 4) std::swap(x, y);
+    return {x, y};
+}
+
+// The board with every tile moved by the symmetry (tiles of each size keep their order)
+template <int N>
+BasicGridState<N> transformed(const BasicGridState<N>& state, int symmetry) {
+    BasicGridState<N> out;
+    for (int k = 1; k <= N; ++k) {
+        for (auto [x, y] : state.tile_coords[k - 1]) {
+            auto [tx, ty] = map_tile<N>(symmetry, k, x, y);
+            out.place_tile(k, tx, ty);
+        }
+    }
+    return out;
+}
+
+// One solver configuration in a portfolio
+struct PortfolioConfig {
+    Ordering ordering;
+    int symmetry;
+};
+
+// Configurations in the order a portfolio of a given size takes them: all eight symmetries
+// with the default ordering first (node counts differ far more between symmetries of a grid
+// than between orderings), then the same with the other orderings
+inline std::vector<PortfolioConfig> portfolio_configs(int size) {
+    const int symmetries[] = {0, 4, 1, 5, 2, 6, 3, 7};
+    const Ordering orderings[] = {Ordering::Largest, Ordering::FewestCopies, Ordering::GapAware};
+    std::vector<PortfolioConfig> configs;
+    for (Ordering ordering : orderings) {
+        for (int symmetry : symmetries) {
+            if (int(configs.size()) < size) configs.push_back({ordering, symmetry});
+        }
+    }
+    return configs;
+}
+
+// Race the configurations on one instance, one thread each
+// The first configuration to complete the board cancels the others. On success state holds
+// that tiling mapped back to the original orientation and *winner (if given) is its index in
+// configs; otherwise state is left unchanged. options.table, if any, is shared by all racers,
+// and every racer's counters (up to its cancellation) are merged into options.stats.
+template <int N>
+bool solve_portfolio(BasicGridState<N>& state, const std::vector<PortfolioConfig>& configs,
+                     const SearchOptions& options = {}, int* winner = nullptr) {
+    std::atomic<bool> stop{false};
+    std::mutex result_mutex;
+    BasicGridState<N> solution;
+    int found = -1;
+
+    auto racer = [&](int id) {
+        const PortfolioConfig& config = configs[id];
+        BasicGridState<N> local = transformed(state, config.symmetry);
+        SearchStats local_stats;
+        SearchOptions local_options;
+        local_options.stop = &stop;
+        local_options.table = options.table;
+        local_options.stats = options.stats ? &local_stats : nullptr;
+        local_options.ordering = config.ordering;
+        const bool solved = solve_puzzle(local, local_options);
+
+        std::lock_guard<std::mutex> lock(result_mutex);
+        if (options.stats) options.stats->merge(local_stats);
+        if (!solved || found != -1) return;
+        found = id;
+        stop = true;
+        // Keep the original tiles as they were and map the new ones back
+        solution = state;
+        for (int k = 1; k <= N; ++k) {
+            const auto& coords = local.tile_coords[k - 1];
+            for (size_t i = state.tile_coords[k - 1].size(); i < coords.size(); ++i) {
+                auto [x, y] = unmap_tile<N>(config.symmetry, k, coords[i].first, coords[i].second);
+                solution.place_tile(k, x, y);
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int i = 0; i < int(configs.size()); ++i) pool.emplace_back(racer, i);
+    for (auto& t : pool) t.join();
+
+    if (found == -1) return false;
+    state = solution;
+    if (winner) *winner = found;
+    return true;
+}
@@ -0,0 +1,106 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include "GridState.h"
+
+// Search counters are compiled in only when building with -DPARTRIDGE_STATS=1. Otherwise the
+// solver's stats pointer is a constant null and every counter update folds away.
+#ifndef PARTRIDGE_STATS
+#define PARTRIDGE_STATS 0
+#endif
+constexpr bool STATS_ENABLED = PARTRIDGE_STATS != 0;
+
+// Why a tile size was not placed at the current cell
+enum class Rejection { OutOfBounds, Overlap, InventoryExhausted, Frontier, Pocket, Transposition, Count };
+
+inline const char* rejection_name(Rejection r) {
+    static const char* names[] = {"out_of_bounds", "overlap", "inventory_exhausted", "frontier", "pocket", "transposition"};
+    return names[int(r)];
+}
+
+// Counters for one instance (the parallel solver merges its workers' counters into one)
+struct SearchStats {
+    static constexpr int MAX_SIZE = 15; // largest tile a 128-bit row can hold
+
+    uint64_t nodes = 0;
+    uint64_t solutions = 0;
+    int max_depth = 0;
+    std::array<uint64_t, MAX_SIZE + 1> tried{};  // placements attempted, by tile size
+    std::array<uint64_t, MAX_SIZE + 1> placed{}; // placements kept, by tile size
+    std::array<uint64_t, int(Rejection::Count)> rejected{};
+    double seconds = 0;
+
+    // Progress lines on stderr every report_every seconds (0 = never)
+    double report_every = 0;
+    int grid = 0;
+
+    void start() {
+        begin = last_report = std::chrono::steady_clock::now();
+        last_nodes = nodes;
+    }
+
+    void finish() { seconds = elapsed(begin); }
+
+    void reject(Rejection r) { ++rejected[int(r)]; }
+
+    // Classify a failed place_tile
+    template <int N>
+    void reject_placement(const BasicGridState<N>& state, int tile_size, int x, int y) {
+        if (state.remaining(tile_size) == 0) reject(Rejection::InventoryExhausted);
+        else if (x + tile_size > Partridge<N>::SIDE || y + tile_size > Partridge<N>::SIDE) reject(Rejection::OutOfBounds);
+        else reject(Rejection::Overlap);
+    }
+
+    // Called by the search every 65536 nodes; prints nodes/sec since the last report when due
+    void heartbeat(int depth) {
+        if (report_every <= 0) return;
+        const double since = elapsed(last_report);
+        if (since < report_every) return;
+        std::fprintf(stderr, "grid %d: %llu nodes, %.0f nodes/sec, depth %d (max %d), %.1fs\n", grid,
+                     (unsigned long long)nodes, double(nodes - last_nodes) / since, depth, max_depth, elapsed(begin));
+        last_report = std::chrono::steady_clock::now();
+        last_nodes = nodes;
+    }
+
+    void merge(const SearchStats& other) {
+        nodes += other.nodes;
+        solutions += other.solutions;
+        if (other.max_depth > max_depth) max_depth = other.max_depth;
+        for (int k = 0; k <= MAX_SIZE; ++k) {
+            tried[k] += other.tried[k];
+            placed[k] += other.placed[k];
+        }
+        for (int r = 0; r < int(Rejection::Count); ++r) rejected[r] += other.rejected[r];
+    }
+
+    // One-line JSON record of the counters, for tiles 1..order
+    std::string json(int order) const {
+        std::string out = "{\"grid\":" + std::to_string(grid) + ",\"order\":" + std::to_string(order) +
+                          ",\"seconds\":" + std::to_string(seconds) + ",\"nodes\":" + std::to_string(nodes) +
+                          ",\"nodes_per_sec\":" + std::to_string(seconds > 0 ? uint64_t(double(nodes) / seconds) : 0) +
+                          ",\"solutions\":" + std::to_string(solutions) + ",\"max_depth\":" + std::to_string(max_depth);
+        out += ",\"tried\":" + size_list(tried, order) + ",\"placed\":" + size_list(placed, order) + ",\"rejected\":{";
+        for (int r = 0; r < int(Rejection::Count); ++r) {
+            if (r > 0) out += ",";
+            out += std::string("\"") + rejection_name(Rejection(r)) + "\":" + std::to_string(rejected[r]);
+        }
+        return out + "}}";
+    }
+
+private:
+    std::chrono::steady_clock::time_point begin, last_report;
+    uint64_t last_nodes = 0;
+
+    static double elapsed(std::chrono::steady_clock::time_point since) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - since).count();
+    }
+
+    static std::string size_list(const std::array<uint64_t, MAX_SIZE + 1>& counts, int order) {
+        std::string out = "[";
+        for (int k = 1; k <= order; ++k) out += (k > 1 ? "," : "") + std::to_string(counts[k]);
+        return out + "]";
+    }
+};
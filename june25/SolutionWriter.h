@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdio>
+#include <cstdint>
+#include <array>
+#include "GridState.h"
+
+// Buffered line-oriented writer for streaming completed tilings
+// One line per solution: "<grid> <index>" followed by " <size>=x,y;x,y;..." for each tile size,
+// e.g. "3 12 1=40,2 2=5,7;9,30 ...". Numbers are formatted by hand into a fixed buffer that is
+// handed to fwrite only when it fills up, so enumeration does no per-character stream output.
+class SolutionWriter {
+public:
+    explicit SolutionWriter(std::FILE* out = stdout) : out(out) {}
+    ~SolutionWriter() { flush(); }
+
+    SolutionWriter(const SolutionWriter&) = delete;
+    SolutionWriter& operator=(const SolutionWriter&) = delete;
+
+    template <int N>
+    void write(int grid, uint64_t index, const BasicGridState<N>& state) {
+        // Longest line: two numbers plus one coordinate pair per tile and a prefix per size
+        if (used + 20 * 2 + 8 * Partridge<N>::TILES + 5 * N + 1 > buffer.size()) flush();
+        put_uint(uint64_t(grid));
+        put(' ');
+        put_uint(index);
+        for (int size = 1; size <= N; ++size) {
+            put(' ');
+            put_uint(uint64_t(size));
+            put('=');
+            const auto& coords = state.tile_coords[size - 1];
+            for (int i = 0; i < int(coords.size()); ++i) {
+                if (i > 0) put(';');
+                put_uint(uint64_t(coords[i].first));
+                put(',');
+                put_uint(uint64_t(coords[i].second));
+            }
+        }
+        put('\n');
+    }
+
+    void flush() {
+        if (used > 0) std::fwrite(buffer.data(), 1, used, out);
+        used = 0;
+        std::fflush(out);
+    }
+
+private:
+    std::FILE* out;
+    std::array<char, 1 << 16> buffer;
+    size_t used = 0;
+
+    void put(char c) { buffer[used++] = c; }
+
+    void put_uint(uint64_t n) {
+        char digits[20];
+        int length = 0;
+        do {
+            digits[length++] = char('0' + n % 10);
+            n /= 10;
+        } while (n != 0);
+        while (length > 0) put(digits[--length]);
+    }
+};
@@ -0,0 +1,383 @@
+#pragma once
+#include <array>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <string>
+#include "GridState.h"
+#include "DancingLinks.h"
+#include "TranspositionTable.h"
+#include "SearchStats.h"
+#include "Ordering.h"
+
+// One level of the search: the empty cell being covered and the tile sizes tried there
+template <int N>
+struct SearchFrame {
+    int x, y;
+    int placed;       // size of the tile currently placed at (x, y), 0 if none
+    int next, count;  // index of the next size to try, and number of sizes to try
+    std::array<int8_t, N> sizes; // tile sizes to try at (x, y), in order
+    uint64_t start_nodes, start_solutions; // counters when the level was entered
+};
+
+// Optional limits and bookkeeping for search_tilings
+// stop: polled every 1024 nodes, the search gives up once it is set
+// max_nodes: give up after this many nodes (0 = no limit)
+// node_count: the number of nodes visited is added to it
+// table: states found to have no completion are stored here and skipped when reached again
+// stats: search counters, ignored unless built with PARTRIDGE_STATS (see SearchStats.h)
+// ordering: the order tile sizes are tried in at each cell (see Ordering.h)
+struct SearchOptions {
+    const std::atomic<bool>* stop = nullptr;
+    uint64_t max_nodes = 0;
+    uint64_t* node_count = nullptr;
+    TranspositionTable* table = nullptr;
+    SearchStats* stats = nullptr;
+    Ordering ordering = Ordering::Largest;
+};
+
+// Backtracking search
+// Mutates state in place and undoes placements from the trail, so the search makes no heap
+// allocations beyond one copy of the caller's pocket list, and its depth is bounded by the
+// number of tiles rather than the native stack.
+// on_solution(state) is called on every completed tiling; if it returns true the search
+// stops there and returns true with that tiling on the board. Otherwise the search carries
+// on, and when the tree is exhausted it returns false with state as it was passed in.
+// See SearchOptions for cancellation, node budgets and the transposition table.
+// A level that exhausts every tile size without reaching a solution is a dead state: its hash
+// (board plus inventory) goes into the table, and placements that recreate it are rejected.
+template <int N, typename OnSolution>
+bool search_tilings(BasicGridState<N>& state, OnSolution on_solution, const SearchOptions& options = {}) {
+    std::array<SearchFrame<N>, Partridge<N>::TILES + 1> trail;
+    int depth = 0;
+    uint64_t nodes = 0, solutions = 0;
+    const std::atomic<bool>* stop = options.stop;
+    TranspositionTable* table = options.table;
+    SearchStats* stats = STATS_ENABLED ? options.stats : nullptr;
+    struct NodeReport { // adds this search's nodes to *node_count on every return path
+        uint64_t* out;
+        const uint64_t& nodes;
+        ~NodeReport() { if (out) *out += nodes; }
+    } report{options.node_count, nodes};
+    struct PocketRestore { // hands the caller's pocket list back on every return path
+        BasicGridState<N>& state;
+        const std::vector<typename BasicGridState<N>::Pocket> saved;
+        ~PocketRestore() { state.pockets.assign(saved.begin(), saved.end()); }
+    } restore{state, state.pockets};
+
+    auto enter = [&](SearchFrame<N>& frame, int x, int y) {
+        frame.x = x;
+        frame.y = y;
+        frame.placed = 0;
+        frame.next = 0;
+        frame.count = order_sizes(state, options.ordering, x, y, frame.sizes);
+        frame.start_nodes = nodes;
+        frame.start_solutions = solutions;
+    };
+
+    // Find first empty cell
+    auto [x, y] = state.find_first_empty();
+
+    // No more empty cells
+    if (x == -1 && y == -1) return on_solution(state);
+
+    // Pockets carved out by the tiles already on the board, replacing the list until we return
+    if (!state.check_all_pockets()) return false;
+
+    enter(trail[0], x, y);
+    while (depth >= 0) {
+        SearchFrame<N>& frame = trail[depth];
+
+        // Undo the tile placed at this level by the previous attempt
+        if (frame.placed != 0) {
+            state.remove_tile(frame.placed, frame.x, frame.y);
+            frame.placed = 0;
+        }
+
+        // Cancelled by another worker or out of budget: unwind the trail and give up
+        ++nodes;
+        if ((stop && (nodes & 1023) == 0 && stop->load(std::memory_order_relaxed)) || nodes == options.max_nodes) {
+            for (int d = depth - 1; d >= 0; --d) state.remove_tile(trail[d].placed, trail[d].x, trail[d].y);
+            return false;
+        }
+        if (stats) {
+            ++stats->nodes;
+            if (depth > stats->max_depth) stats->max_depth = depth;
+            if ((stats->nodes & 0xFFFF) == 0) stats->heartbeat(depth);
+        }
+
+        // Try placing each remaining tile size in the frame's order, rejecting placements that
+        // leave a skyline gap or an enclosed pocket the remaining tiles cannot fill, or that
+        // reach a state already known to be dead
+        int tile_size = 0;
+        while (tile_size == 0 && frame.next < frame.count) {
+            const int k = frame.sizes[frame.next++];
+            if (stats) ++stats->tried[k];
+            if (!state.place_tile(k, frame.x, frame.y)) {
+                if (stats) stats->reject_placement(state, k, frame.x, frame.y);
+                continue;
+            }
+            if (!state.frontier_feasible(k, frame.x)) {
+                if (stats) stats->reject(Rejection::Frontier);
+            } else if (!state.check_pockets(k, frame.x, frame.y)) {
+                if (stats) stats->reject(Rejection::Pocket);
+            } else if (table && table->contains(state.hash)) {
+                if (stats) stats->reject(Rejection::Transposition);
+            } else {
+                tile_size = k;
+                continue;
+            }
+            state.remove_tile(k, frame.x, frame.y);
+        }
+
+        // No tile fits here: remember the state if nothing below it completed, and backtrack
+        if (tile_size == 0) {
+            if (table && solutions == frame.start_solutions) table->store(state.hash, nodes - frame.start_nodes);
+            --depth;
+            continue;
+        }
+
+        frame.placed = tile_size;
+        if (stats) ++stats->placed[tile_size];
+
+        // Descend to the next empty cell, or report the completed board and carry on at this level
+        auto [next_x, next_y] = state.find_first_empty();
+        if (next_x == -1 && next_y == -1) {
+            ++solutions;
+            if (stats) ++stats->solutions;
+            if (on_solution(state)) return true;
+            continue;
+        }
+        enter(trail[++depth], next_x, next_y);
+    }
+
+    // No (further) solution found from this state
+    return false;
+}
+
+// Backtracking solver function
+// On success state holds the first completed tiling, otherwise it is left as it was passed in.
+template <int N>
+bool solve_puzzle(BasicGridState<N>& state, const SearchOptions& options = {}) {
+    return search_tilings(state, [](const BasicGridState<N>&) { return true; }, options);
+}
+
+// Visit every completion of state (up to limit, 0 = no limit), returning how many were found.
+// state is left as it was passed in unless the limit cut the search short.
+template <int N, typename OnSolution>
+uint64_t enumerate_solutions(BasicGridState<N>& state, OnSolution on_solution, uint64_t limit = 0,
+                             const SearchOptions& options = {}) {
+    uint64_t count = 0;
+    search_tilings(state, [&](const BasicGridState<N>& solved) {
+        ++count;
+        on_solution(solved, count);
+        return limit != 0 && count >= limit;
+    }, options);
+    return count;
+}
+
+// --------------------------------------------------------------------------------------------------------//
+// Parallel search within one instance
+
+// A tile placed on the way from the root board to a subproblem
+struct Placement {
+    int8_t size, x, y;
+};
+
+// A subproblem: the root board plus the first `depth` placements of `path`
+template <int N>
+struct SearchTask {
+    int depth = 0;
+    std::array<Placement, Partridge<N>::TILES> path;
+};
+
+// Task deque owned by one worker: the owner pushes and pops at the back (depth first),
+// idle workers steal the oldest, shallowest tasks from the front
+template <int N>
+class TaskDeque {
+public:
+    void push(const SearchTask<N>& task) {
+        std::lock_guard<std::mutex> lock(m);
+        tasks.push_back(task);
+    }
+
+    bool pop(SearchTask<N>& task) {
+        std::lock_guard<std::mutex> lock(m);
+        if (tasks.empty()) return false;
+        task = tasks.back();
+        tasks.pop_back();
+        return true;
+    }
+
+    bool steal(SearchTask<N>& task) {
+        std::lock_guard<std::mutex> lock(m);
+        if (tasks.empty()) return false;
+        task = tasks.front();
+        tasks.pop_front();
+        return true;
+    }
+
+private:
+    std::mutex m;
+    std::deque<SearchTask<N>> tasks;
+};
+
+// Trees the serial search finishes within this many nodes are not worth splitting: rebuilding
+// every task from the root costs more than the search itself (the nine puzzle grids all finish
+// within 15000 nodes, and splitting them ran at 0.2-0.5x the serial speed)
+constexpr uint64_t SERIAL_PROBE_NODES = 200000;
+
+// Work-stealing solver for a single instance
+// The instance is first searched serially for up to SERIAL_PROBE_NODES nodes, and only split if
+// that runs out. Nodes shallower than split_depth are expanded into one task per placeable tile size;
+// deeper tasks are solved with solve_puzzle. Workers with nothing to pop or steal sleep until
+// a task is pushed, the last task finishes or the board is completed. The first worker to
+// complete the board cancels the others. On success state holds the completed tiling (not
+// necessarily the one the serial solver would find), otherwise it is left unchanged. The transposition table
+// in options, if any, is shared by all workers; their stats are merged into options.stats.
+template <int N>
+bool solve_puzzle_parallel(BasicGridState<N>& state, int workers, int split_depth = 4, const SearchOptions& options = {}) {
+    if (workers <= 1) return solve_puzzle(state, options);
+
+    // Serial probe: small trees are solved (or refuted) here and never split
+    uint64_t probe_nodes = 0;
+    SearchOptions probe = options;
+    probe.max_nodes = options.max_nodes ? std::min(options.max_nodes, SERIAL_PROBE_NODES) : SERIAL_PROBE_NODES;
+    probe.node_count = &probe_nodes;
+    const bool probe_solved = solve_puzzle(state, probe);
+    if (options.node_count) *options.node_count += probe_nodes;
+    if (probe_solved) return true;
+    if (probe_nodes < probe.max_nodes || probe.max_nodes == options.max_nodes) return false; // searched in full, stopped or out of budget
+
+    // Tasks are rebuilt from a copy of the board that tracks its pockets
+    BasicGridState<N> root = state;
+    if (!root.check_all_pockets()) return false;
+
+    std::vector<TaskDeque<N>> deques(workers);
+    std::atomic<bool> stop{false};
+    std::atomic<int> pending{1}; // tasks pushed but not yet finished
+    std::atomic<int> queued{1};  // tasks pushed but not yet taken
+    std::mutex result_mutex;
+    BasicGridState<N> solution;
+    bool found = false;
+
+    std::mutex idle_mutex;
+    std::condition_variable idle;
+    auto wake_idle = [&]() {
+        std::lock_guard<std::mutex> lock(idle_mutex);
+        idle.notify_all();
+    };
+
+    deques[0].push(SearchTask<N>{});
+
+    auto worker = [&](int id) {
+        BasicGridState<N> local = root;
+        SearchTask<N> task;
+        SearchStats local_stats;
+        SearchOptions local_options;
+        local_options.stop = &stop;
+        local_options.table = options.table;
+        local_options.stats = options.stats ? &local_stats : nullptr;
+        local_options.ordering = options.ordering;
+        struct MergeStats { // hands this worker's counters to the caller when it exits
+            std::mutex& m;
+            SearchStats* out;
+            const SearchStats& local;
+            ~MergeStats() {
+                if (!out) return;
+                std::lock_guard<std::mutex> lock(m);
+                out->merge(local);
+            }
+        } merge{result_mutex, options.stats, local_stats};
+        while (!stop.load(std::memory_order_relaxed)) {
+            // Take our own newest task, otherwise steal from the other workers in turn
+            bool have_task = deques[id].pop(task);
+            for (int i = 1; i < workers && !have_task; ++i) have_task = deques[(id + i) % workers].steal(task);
+            if (!have_task) {
+                std::unique_lock<std::mutex> lock(idle_mutex);
+                idle.wait(lock, [&]() { return queued.load() > 0 || pending.load() == 0 || stop.load(); });
+                if (pending.load() == 0) return;
+                continue;
+            }
+            --queued;
+
+            // Rebuild the subproblem from the root board
+            local = root;
+            for (int d = 0; d < task.depth; ++d) {
+                const Placement& p = task.path[d];
+                local.place_tile(p.size, p.x, p.y);
+                local.check_pockets(p.size, p.x, p.y);
+            }
+
+            bool solved = false;
+            if (task.depth < split_depth) {
+                auto [x, y] = local.find_first_empty();
+                if (x == -1 && y == -1) {
+                    solved = true;
+                } else {
+                    // Push in reverse so that our own pops try sizes in the same order as the serial search
+                    std::array<int8_t, N> sizes;
+                    for (int i = order_sizes(local, options.ordering, x, y, sizes) - 1; i >= 0; --i) {
+                        const int tile_size = sizes[i];
+                        if (!local.place_tile(tile_size, x, y)) continue;
+                        const bool feasible = local.frontier_feasible(tile_size, x) && local.check_pockets(tile_size, x, y);
+                        local.remove_tile(tile_size, x, y);
+                        if (!feasible) continue;
+                        SearchTask child = task;
+                        child.path[child.depth++] = {int8_t(tile_size), int8_t(x), int8_t(y)};
+                        ++pending;
+                        ++queued;
+                        deques[id].push(child);
+                    }
+                    wake_idle();
+                }
+            } else {
+                solved = solve_puzzle(local, local_options);
+            }
+
+            if (solved) {
+                std::lock_guard<std::mutex> lock(result_mutex);
+                if (!found) {
+                    found = true;
+                    solution = local;
+                    stop = true;
+                }
+            }
+            if (--pending == 0 || stop.load()) wake_idle();
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int i = 0; i < workers; ++i) pool.emplace_back(worker, i);
+    for (auto& t : pool) t.join();
+
+    if (found) state = solution;
+    return found;
+}
+
+// --------------------------------------------------------------------------------------------------------//
+
+// Solver engines selectable at runtime
+enum class Engine { Backtrack, DancingLinks };
+
+// Parse an engine name ("backtrack" or "dlx"); returns false if it is not recognised
+inline bool parse_engine(const std::string& name, Engine& engine) {
+    if (name == "backtrack") engine = Engine::Backtrack;
+    else if (name == "dlx") engine = Engine::DancingLinks;
+    else return false;
+    return true;
+}
+
+// Dancing links only honours options.stop and options.stats
+template <int N>
+bool solve_with(Engine engine, BasicGridState<N>& state, const SearchOptions& options = {}) {
+    switch (engine) {
+        case Engine::DancingLinks: return solve_puzzle_dlx(state, options.stop, options.stats);
+        case Engine::Backtrack: break;
+    }
+    return solve_puzzle(state, options);
+}
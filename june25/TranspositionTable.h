@@ -0,0 +1,88 @@
+#pragma once
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+// Fixed-size table of board hashes already known to have no completion
+// Entries are grouped into buckets of four that share one cache line; a key's bucket is chosen
+// by its low bits. Each entry holds the key XORed with its payload plus the payload itself,
+// so a reader that races with a writer sees a mismatched pair and treats it as a miss rather
+// than a torn hit. That lets workers share one table without locks. When a bucket is full the
+// entry whose subtree took the fewest nodes to refute is replaced.
+class TranspositionTable {
+public:
+    struct Stats {
+        uint64_t probes, hits, stores, replacements;
+        double hit_rate() const { return probes ? double(hits) / double(probes) : 0.0; }
+    };
+
+    // Size the table to the largest power-of-two bucket count within megabytes (at least one bucket)
+    explicit TranspositionTable(size_t megabytes) {
+        size_t buckets = 1;
+        while (buckets * 2 * sizeof(Bucket) <= megabytes * 1024 * 1024) buckets *= 2;
+        table = std::vector<Bucket>(buckets);
+        mask = buckets - 1;
+    }
+
+    TranspositionTable(const TranspositionTable&) = delete;
+    TranspositionTable& operator=(const TranspositionTable&) = delete;
+
+    // Whether key was stored as a failed state
+    bool contains(uint64_t key) {
+        probes.fetch_add(1, std::memory_order_relaxed);
+        const Bucket& bucket = table[key & mask];
+        for (const Entry& e : bucket.entries) {
+            const uint64_t work = e.work.load(std::memory_order_relaxed);
+            if (work != 0 && (e.check.load(std::memory_order_relaxed) ^ work) == key) {
+                hits.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Record key as a failed state whose refutation took `work` nodes
+    void store(uint64_t key, uint64_t work) {
+        if (work == 0) work = 1; // zero marks an empty entry
+        stores.fetch_add(1, std::memory_order_relaxed);
+        Bucket& bucket = table[key & mask];
+        Entry* victim = &bucket.entries[0];
+        uint64_t victim_work = UINT64_MAX;
+        for (Entry& e : bucket.entries) {
+            const uint64_t w = e.work.load(std::memory_order_relaxed);
+            if (w != 0 && (e.check.load(std::memory_order_relaxed) ^ w) == key) {
+                victim = &e; // already present: refresh it
+                victim_work = 0;
+                break;
+            }
+            if (w < victim_work) {
+                victim = &e;
+                victim_work = w;
+            }
+        }
+        if (victim_work != 0 && victim_work != UINT64_MAX) replacements.fetch_add(1, std::memory_order_relaxed);
+        victim->check.store(key ^ work, std::memory_order_relaxed);
+        victim->work.store(work, std::memory_order_relaxed);
+    }
+
+    Stats stats() const {
+        return {probes.load(), hits.load(), stores.load(), replacements.load()};
+    }
+
+    size_t capacity() const { return table.size() * 4; }
+    size_t bytes() const { return table.size() * sizeof(Bucket); }
+
+private:
+    struct Entry {
+        std::atomic<uint64_t> check{0}; // key ^ work
+        std::atomic<uint64_t> work{0};  // nodes spent refuting the state, 0 if the entry is empty
+    };
+    struct alignas(64) Bucket {
+        Entry entries[4];
+    };
+
+    std::vector<Bucket> table;
+    size_t mask = 0;
+    std::atomic<uint64_t> probes{0}, hits{0}, stores{0}, replacements{0};
+};
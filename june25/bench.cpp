@@ -0,0 +1,278 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <vector>
+#include <utility> // for pair
+#include "Tilings.h"
+#include "GridState.h"
+#include "Solver.h"
+using namespace std;
+
+// Time one solver run on a fresh copy of the instance, returning milliseconds (-1 if it failed)
+template <typename Solve>
+double time_solve(const GridState& initial, Solve solve) {
+    GridState state = initial;
+    auto start = chrono::steady_clock::now();
+    bool found = solve(state);
+    auto end = chrono::steady_clock::now();
+    if (!found || state.empty_cells() != 0) return -1;
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+// Best of `reps` runs
+template <typename Solve>
+double best_of(int reps, const GridState& initial, Solve solve) {
+    double best = -1;
+    for (int r = 0; r < reps; ++r) {
+        double ms = time_solve(initial, solve);
+        if (ms < 0) return -1;
+        if (best < 0 || ms < best) best = ms;
+    }
+    return best;
+}
+
+// Placements that fit on the initial board of every grid, used as the micro-benchmark workload
+vector<pair<GridState, vector<Placement>>> micro_workload() {
+    vector<pair<GridState, vector<Placement>>> work;
+    for (const auto& tiling : all_initial_tilings) {
+        GridState state = initial_state(tiling);
+        vector<Placement> placements;
+        for (int k = 1; k <= 9; ++k) {
+            for (int y = 0; y < GridState::SIDE; ++y) {
+                for (int x = 0; x < GridState::SIDE; ++x) {
+                    if (state.can_place(k, x, y)) placements.push_back({int8_t(k), int8_t(x), int8_t(y)});
+                }
+            }
+        }
+        work.emplace_back(state, placements);
+    }
+    return work;
+}
+
+// Nanoseconds per operation of op(state, placement), run over the workload until at least
+// min_ops operations are done; best of reps
+template <typename Op>
+double micro_ns(int reps, long min_ops, Op op) {
+    auto work = micro_workload();
+    double best = -1;
+    for (int r = 0; r < reps; ++r) {
+        long ops = 0;
+        auto start = chrono::steady_clock::now();
+        while (ops < min_ops) {
+            for (auto& [state, placements] : work) {
+                for (const Placement& p : placements) op(state, p);
+                ops += long(placements.size());
+            }
+        }
+        double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / double(ops);
+        if (best < 0 || ns < best) best = ns;
+    }
+    return best;
+}
+
+// Boards on the way to each grid's solution: the initial board plus the first t tiles of the
+// solution, taken in row-major order of their top-left corners, for every t. They are built with
+// place_tile only, so find_first_empty starts its scan at row 0 and walks past every full row.
+vector<GridState> find_workload() {
+    vector<GridState> boards;
+    for (const auto& tiling : all_initial_tilings) {
+        GridState state = initial_state(tiling);
+        GridState solved = state;
+        if (!solve_puzzle(solved)) continue;
+        vector<Placement> added;
+        for (int k = 1; k <= 9; ++k) {
+            const auto& coords = solved.tile_coords[k - 1];
+            for (size_t i = state.tile_coords[k - 1].size(); i < coords.size(); ++i) {
+                added.push_back({int8_t(k), int8_t(coords[i].first), int8_t(coords[i].second)});
+            }
+        }
+        sort(added.begin(), added.end(), [](const Placement& a, const Placement& b) { return make_pair(a.y, a.x) < make_pair(b.y, b.x); });
+        boards.push_back(state);
+        for (const Placement& p : added) {
+            state.place_tile(p.size, p.x, p.y);
+            boards.push_back(state);
+        }
+    }
+    return boards;
+}
+
+// Nanoseconds per find_first_empty call on a fresh copy of each workload board, until at least
+// min_ops calls are done; best of reps. Only the calls are timed, not the copies.
+double find_first_empty_ns(int reps, long min_ops) {
+    const vector<GridState> boards = find_workload();
+    volatile int sink = 0;
+    double best = -1;
+    for (int r = 0; r < reps; ++r) {
+        long ops = 0;
+        double total = 0;
+        while (ops < min_ops) {
+            vector<GridState> batch = boards;
+            auto start = chrono::steady_clock::now();
+            for (const GridState& s : batch) sink = sink + s.find_first_empty().second;
+            total += chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+            ops += long(batch.size());
+        }
+        double ns = total / double(ops);
+        if (best < 0 || ns < best) best = ns;
+    }
+    return best;
+}
+
+// Nodes the serial backtracker visits to solve an instance with the given ordering
+uint64_t count_nodes(const GridState& initial, Ordering ordering) {
+    GridState state = initial;
+    uint64_t nodes = 0;
+    SearchOptions options;
+    options.node_count = &nodes;
+    options.ordering = ordering;
+    solve_puzzle(state, options);
+    return nodes;
+}
+
+// Tile the empty board of order N with the serial backtracker, stopping after node_budget nodes
+template <int N>
+void scaling_row(uint64_t node_budget) {
+    BasicGridState<N> state;
+    uint64_t nodes = 0;
+    auto start = chrono::steady_clock::now();
+    SearchOptions options;
+    options.node_count = &nodes;
+    options.max_nodes = node_budget;
+    bool found = search_tilings(state, [](const BasicGridState<N>&) { return true; }, options);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << fixed << setprecision(3) << setw(5) << N << setw(6) << Partridge<N>::SIDE << setw(14) << nodes
+         << setw(14) << setprecision(0) << nodes / seconds << setw(12) << setprecision(3) << seconds
+         << (found ? "  solved" : "  budget exhausted") << "\n";
+}
+
+int main(int argc, char* argv[]) {
+    int workers = max(1u, thread::hardware_concurrency());
+    int reps = 5;
+    bool scaling = false, micro = false, json = false, orderings = false;
+    uint64_t node_budget = 100000000;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc) workers = max(1, stoi(argv[++i]));
+        else if (arg == "--reps" && i + 1 < argc) reps = max(1, stoi(argv[++i]));
+        else if (arg == "--scaling") scaling = true;
+        else if (arg == "--micro") micro = true;
+        else if (arg == "--json") json = true;
+        else if (arg == "--orderings") orderings = true;
+        else if (arg == "--node-budget" && i + 1 < argc) node_budget = stoull(argv[++i]);
+    }
+
+    // Nodes/sec and time to solution per Partridge order, from the empty board
+    if (scaling) {
+        cout << "order  side         nodes     nodes/sec   seconds   (budget " << node_budget << " nodes)\n";
+        scaling_row<8>(node_budget);
+        scaling_row<9>(node_budget);
+        scaling_row<10>(node_budget);
+        scaling_row<11>(node_budget);
+        scaling_row<12>(node_budget);
+        return 0;
+    }
+
+    // Hot paths of the backtracker: one placement and its undo, the same with the first-empty-cell
+    // scan in between (as the search does it), the scan on its own from a stale first open row,
+    // and a full board copy (as the parallel solver does)
+    if (micro || json) {
+        const long min_ops = 2000000;
+        volatile int sink = 0;
+        double place_undo = micro_ns(reps, min_ops, [](GridState& s, const Placement& p) {
+            s.place_tile(p.size, p.x, p.y);
+            s.remove_tile(p.size, p.x, p.y);
+        });
+        double place_find_undo = micro_ns(reps, min_ops, [&](GridState& s, const Placement& p) {
+            s.place_tile(p.size, p.x, p.y);
+            sink = sink + s.find_first_empty().first;
+            s.remove_tile(p.size, p.x, p.y);
+        });
+        double find = find_first_empty_ns(reps, min_ops / 10);
+        double copy = micro_ns(reps, min_ops / 10, [&](GridState& s, const Placement&) {
+            GridState c = s;
+            sink = sink + c.placed;
+        });
+        if (json) {
+            cout << fixed << setprecision(2);
+            cout << "{\"bench\":\"place_undo\",\"ns_per_op\":" << place_undo << "}\n";
+            cout << "{\"bench\":\"place_find_undo\",\"ns_per_op\":" << place_find_undo << "}\n";
+            cout << "{\"bench\":\"find_first_empty\",\"ns_per_op\":" << find << "}\n";
+            cout << "{\"bench\":\"state_copy\",\"ns_per_op\":" << copy << "}\n";
+        } else {
+            cout << "operation               ns/op   (best of " << reps << ")\n";
+            cout << fixed << setprecision(2) << "place+undo         " << setw(10) << place_undo << "\n"
+                 << "place+find+undo    " << setw(10) << place_find_undo << "\n"
+                 << "find_first_empty   " << setw(10) << find << "\n"
+                 << "state copy         " << setw(10) << copy << "\n";
+            return 0;
+        }
+    }
+
+    // Nodes per grid under each value ordering
+    if (orderings) {
+        cout << "grid";
+        for (Ordering o : ALL_ORDERINGS) cout << setw(10) << ordering_name(o);
+        cout << "\n";
+        vector<uint64_t> totals(size(ALL_ORDERINGS), 0);
+        for (int g = 0; g < int(all_initial_tilings.size()); ++g) {
+            GridState initial = initial_state(all_initial_tilings[g]);
+            cout << setw(4) << g + 1;
+            for (int i = 0; i < int(size(ALL_ORDERINGS)); ++i) {
+                uint64_t nodes = count_nodes(initial, ALL_ORDERINGS[i]);
+                totals[i] += nodes;
+                cout << setw(10) << nodes;
+            }
+            cout << "\n";
+        }
+        cout << " all";
+        for (uint64_t total : totals) cout << setw(10) << total;
+        cout << "\n";
+        return 0;
+    }
+
+    // The nine grids, one JSON record each: node count of the serial search (deterministic, so
+    // it must match between runs of the same commit) and best times of each solver
+    if (json) {
+        for (int g = 0; g < int(all_initial_tilings.size()); ++g) {
+            GridState initial = initial_state(all_initial_tilings[g]);
+            uint64_t nodes = count_nodes(initial, Ordering::Largest);
+            double serial = best_of(reps, initial, [](GridState& s) { return solve_puzzle(s); });
+            double parallel = best_of(reps, initial, [&](GridState& s) { return solve_puzzle_parallel(s, workers); });
+            double dlx = best_of(reps, initial, [](GridState& s) { return solve_puzzle_dlx(s); });
+            cout << fixed << setprecision(3) << "{\"bench\":\"grid\",\"grid\":" << g + 1 << ",\"nodes\":" << nodes
+                 << ",\"serial_ms\":" << serial << ",\"parallel_ms\":" << parallel << ",\"dlx_ms\":" << dlx
+                 << ",\"threads\":" << workers << "}\n";
+            for (Ordering o : ALL_ORDERINGS) {
+                cout << "{\"bench\":\"ordering\",\"grid\":" << g + 1 << ",\"ordering\":\"" << ordering_name(o)
+                     << "\",\"nodes\":" << count_nodes(initial, o) << "}\n";
+            }
+        }
+        return 0;
+    }
+
+    // Serial first-empty backtracker vs work-stealing search vs dancing links on each shipped instance
+    cout << "grid  serial_ms  parallel_ms  speedup    dlx_ms  dlx/serial   (" << workers << " threads, best of " << reps << ")\n";
+    double serial_total = 0, parallel_total = 0, dlx_total = 0;
+    for (int g = 0; g < int(all_initial_tilings.size()); ++g) {
+        GridState initial = initial_state(all_initial_tilings[g]);
+        double serial = best_of(reps, initial, [](GridState& s) { return solve_puzzle(s); });
+        double parallel = best_of(reps, initial, [&](GridState& s) { return solve_puzzle_parallel(s, workers); });
+        double dlx = best_of(reps, initial, [](GridState& s) { return solve_puzzle_dlx(s); });
+        if (serial < 0 || parallel < 0 || dlx < 0) {
+            cout << setw(4) << g + 1 << "  no solution\n";
+            continue;
+        }
+        serial_total += serial;
+        parallel_total += parallel;
+        dlx_total += dlx;
+        cout << fixed << setprecision(3) << setw(4) << g + 1 << setw(11) << serial << setw(13) << parallel
+             << setw(9) << serial / parallel << setw(10) << dlx << setw(12) << dlx / serial << "\n";
+    }
+    cout << fixed << setprecision(3) << " all" << setw(11) << serial_total << setw(13) << parallel_total
+         << setw(9) << serial_total / parallel_total << setw(10) << dlx_total << setw(12) << dlx_total / serial_total << "\n";
+
+    return 0;
+}
@@ -3,88 +3,23 @@
 #include <utility> // for pair
 #include <algorithm> // for min
 #include <iomanip> // for setw
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <memory>
 #include "Tilings.h"
+#include "GridState.h"
+#include "Solver.h"
+#include "SolutionWriter.h"
+#include "Portfolio.h"
 using namespace std;
 
-class GridState {
-public:
-    vector<vector<bool>> grid; // 45x45 grid, true = occupied
-    vector<vector<pair<int, int>>> tile_coords; // tile_coords[0] = 1x1 tiles, etc.
-
-    GridState() : grid(45, vector<bool>(45, false)), tile_coords(9) {} // 9 vectors for 1x1 to 9x9 tiles
-
-    // Function to place a tile
-    bool place_tile(int tile_size, int x, int y) {
-        // Check if we've already placed all tiles of this size
-        if (tile_coords[tile_size - 1].size() >= tile_size) return false;
-
-        // Check if tile would go out of bounds
-        if (x + tile_size > 45 || y + tile_size > 45) return false;
-
-        // Check for occupied cells in the tile area
-        for (int i = x; i < x + tile_size; ++i) {
-            for (int j = y; j < y + tile_size; ++j) {
-                if (grid[i][j]) return false;
-            }
-        }
-
-        // Place tile
-        for (int i = x; i < x + tile_size; ++i) {
-            for (int j = y; j < y + tile_size; ++j) {
-                grid[i][j] = true;
-            }
-        }
-
-        tile_coords[tile_size - 1].emplace_back(x, y);
-        return true;
-    }
-
-    // Function to find first empty cell (top-left to bottom-right)
-    pair<int, int> find_first_empty() const {
-        for (int y = 0; y < 45; ++y) {
-            for (int x = 0; x < 45; ++x) {
-                if (!grid[x][y]) {
-                    return {x, y};
-                }
-            }
-        }
-        return {-1, -1}; // no empty cell found
-    }
-
-};
-
-// Backtracking solver function
-bool solve_puzzle(GridState& state) {
-
-    // Find first empty cell
-    auto [x, y] = state.find_first_empty();
-
-    // No more empty cells
-    if (x == -1 && y == -1) return true; 
-
-    // Try placing each possible tile size (from largest to smallest for efficiency)
-    for (int tile_size = 9; tile_size >= 1; --tile_size) {
-        // Make copy of the current state for backtracking
-        GridState new_state = state;
-
-        // Try to place the tile
-        if (new_state.place_tile(tile_size, x, y)) {
-            // Recursively try to solve the new state
-            if (solve_puzzle(new_state)) {
-                // If solved, update the original state and return
-                state = new_state;
-                return true;
-            }
-        }
-    }
-
-    // No solution found from this state
-    return false;
-}
-
 // Helper function to print tile coordinates for debugging
-void print_tile_coords(const GridState& state) {
-    for (int size = 1; size <= 9; ++size) {
+template <int N>
+void print_tile_coords(const BasicGridState<N>& state) {
+    for (int size = 1; size <= N; ++size) {
         cout << size << "x" << size << " tiles (" 
              << state.tile_coords[size-1].size() << "/" << size << "):" << endl;
         for (const auto& coord : state.tile_coords[size-1]) {
@@ -94,12 +29,15 @@ void print_tile_coords(const GridState& state) {
 }
 
 // Print grind 
-void print_grid(const GridState& state) {
-    // Create a 45x45 grid to store tile sizes
-    std::vector<std::vector<int>> display_grid(45, std::vector<int>(45, 0));
+template <int N>
+void print_grid(const BasicGridState<N>& state) {
+    constexpr int SIDE = Partridge<N>::SIDE;
+
+    // Create a SIDE x SIDE grid to store tile sizes
+    std::vector<std::vector<int>> display_grid(SIDE, std::vector<int>(SIDE, 0));
     
     // Fill the display grid with tile sizes
-    for (int size = 1; size <= 9; ++size) {
+    for (int size = 1; size <= N; ++size) {
         for (const auto& coord : state.tile_coords[size-1]) {
             int x = coord.first;
             int y = coord.second;
@@ -113,17 +51,17 @@ void print_grid(const GridState& state) {
 
     // Print top axis (column numbers)
     std::cout << "  "; // Space for row numbers
-    for (int x = 0; x < 45; ++x) {
+    for (int x = 0; x < SIDE; ++x) {
         std::cout << std::setw(2) << x % 10; // Only show last digit for compactness
     }
     std::cout << "\n";
 
     // Print grid with left axis (row numbers)
-    for (int y = 0; y < 45; ++y) {
+    for (int y = 0; y < SIDE; ++y) {
         // Print row number
         std::cout << std::setw(2) << y << " ";
         
-        for (int x = 0; x < 45; ++x) {
+        for (int x = 0; x < SIDE; ++x) {
             int size = display_grid[x][y];
             if (size == 0) {
                 std::cout << "  ";
@@ -139,6 +77,7 @@ void print_grid(const GridState& state) {
                     case 7: std::cout << "\033[38;2;255;235;59m"; break;   // yellow
                     case 8: std::cout << "\033[38;2;109;76;65m"; break;    // brown
                     case 9: std::cout << "\033[38;2;178;235;242m"; break;  // transparent
+                    default: std::cout << "\033[38;2;255;255;255m"; break; // white (orders above 9)
                 }
                 std::cout << "X\033[0m "; // Reset color after X
             }
@@ -147,33 +86,248 @@ void print_grid(const GridState& state) {
     }
 }
 
-int main() {
-    GridState state;
+struct BatchResult {
+    GridState initial; // pre-placed tiles only
+    GridState solved;  // completed tiling if found
+    bool found = false;
+    SearchStats stats;
+};
+
+// Solve one instance, filling in *stats (with timing and progress reports) if it is given
+template <int N>
+bool solve_instance(BasicGridState<N>& state, Engine engine, bool split, int workers, SearchOptions options, SearchStats* stats) {
+    if (stats) {
+        options.stats = stats;
+        stats->report_every = 1.0;
+        stats->start();
+    }
+    bool found = split && engine == Engine::Backtrack ? solve_puzzle_parallel(state, workers, 4, options)
+                                                      : solve_with(engine, state, options);
+    if (stats) stats->finish();
+    return found;
+}
 
-    for (int g = 0; g < 9; ++g){
-        std::vector<std::vector<std::pair<int, int>>> initial_tiling = all_initial_tilings[g];
+// Solve every instance on a pool of `workers` threads, each with its own GridState.
+// Results are handed to emit(g, result) in input order, each one as soon as it and all
+// earlier instances are done.
+template <typename Emit>
+void solve_batch(const vector<Tiling>& tilings, int workers, Engine engine, const SearchOptions& options, bool stats, Emit emit) {
+    const int n = int(tilings.size());
+    vector<BatchResult> results(n);
+    vector<bool> done(n, false);
+    mutex m;
+    condition_variable cv;
+    atomic<int> next_instance{0};
 
-        // Place initial tiles
-        for (int i = 0; i < int(initial_tiling.size()); ++i) {
-            for (const auto& coord : initial_tiling[i]) {
-                state.place_tile(i + 1, coord.first, coord.second);
+    auto worker = [&]() {
+        for (int g = next_instance++; g < n; g = next_instance++) {
+            BatchResult result;
+            result.initial = initial_state(tilings[g]);
+            result.solved = result.initial;
+            result.stats.grid = g + 1;
+            result.found = solve_instance(result.solved, engine, false, 1, options, stats ? &result.stats : nullptr);
+            {
+                lock_guard<mutex> lock(m);
+                results[g] = move(result);
+                done[g] = true;
             }
+            cv.notify_all();
         }
+    };
+
+    vector<thread> pool;
+    for (int i = 0; i < min(workers, n); ++i) pool.emplace_back(worker);
 
+    for (int g = 0; g < n; ++g) {
+        unique_lock<mutex> lock(m);
+        cv.wait(lock, [&] { return bool(done[g]); });
+        BatchResult result = move(results[g]);
+        lock.unlock();
+        emit(g, result);
+    }
+
+    for (auto& t : pool) t.join();
+}
+
+// Tile the empty board of Partridge order N and print the result
+template <int N>
+void solve_empty_board(Engine engine, bool split, int workers, const SearchOptions& options, bool stats) {
+    BasicGridState<N> state;
+    SearchStats search_stats;
+    bool found = solve_instance(state, engine, split, workers, options, stats ? &search_stats : nullptr);
+    if (stats) cerr << search_stats.json(N) << "\n";
+    if (found) {
+        cout << "Partridge tiling of order " << N << ": \n";
+        print_grid(state);
+    } else {
+        cout << "No Partridge tiling of order " << N << "\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    // Number of worker threads: --threads N (defaults to one per hardware thread)
+    // --split: solve the grids one at a time, each with a work-stealing search over all workers
+    // --engine backtrack|dlx: first-empty-cell backtracker (default) or dancing-links exact cover
+    // --count: count the completions of each grid instead of printing the first one
+    // --enumerate: stream every completion as one line of tile coordinates (see SolutionWriter.h)
+    // --max-solutions N: stop counting/enumerating a grid after N completions
+    // --order N: instead of the puzzle grids, tile the empty board of Partridge order N (8..12)
+    // --tt-mb N: share an N-megabyte table of dead states between all searches (0 = off, the default)
+    // --stats: report search progress every second and a JSON record of counters per grid, on stderr
+    //          (needs a build with -DPARTRIDGE_STATS=1)
+    // --ordering largest|fits|fewest|gap: order the backtracker tries tile sizes in (see Ordering.h)
+    // --portfolio N: race N configurations (ordering and board symmetry) on each grid, first answer wins
+    int workers = max(1u, thread::hardware_concurrency());
+    bool split = false;
+    bool count = false, enumerate = false;
+    uint64_t max_solutions = 0;
+    int order = 0;
+    size_t tt_mb = 0;
+    bool stats = false;
+    Ordering ordering = Ordering::Largest;
+    int portfolio = 0;
+    Engine engine = Engine::Backtrack;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc) workers = max(1, stoi(argv[++i]));
+        else if (arg == "--split") split = true;
+        else if (arg == "--count") count = true;
+        else if (arg == "--enumerate") enumerate = true;
+        else if (arg == "--max-solutions" && i + 1 < argc) max_solutions = stoull(argv[++i]);
+        else if (arg == "--order" && i + 1 < argc) order = stoi(argv[++i]);
+        else if (arg == "--tt-mb" && i + 1 < argc) tt_mb = stoull(argv[++i]);
+        else if (arg == "--stats") stats = true;
+        else if (arg == "--portfolio" && i + 1 < argc) portfolio = max(1, stoi(argv[++i]));
+        else if (arg == "--ordering" && i + 1 < argc) {
+            if (!parse_ordering(argv[++i], ordering)) {
+                cerr << "Unknown ordering " << argv[i] << " (expected largest, fits, fewest or gap)\n";
+                return 1;
+            }
+        }
+        else if (arg == "--engine" && i + 1 < argc) {
+            if (!parse_engine(argv[++i], engine)) {
+                cerr << "Unknown engine " << argv[i] << " (expected backtrack or dlx)\n";
+                return 1;
+            }
+        }
+    }
+
+    if (stats && !STATS_ENABLED) {
+        cerr << "--stats needs the search counters: rebuild with -DPARTRIDGE_STATS=1\n";
+        return 1;
+    }
+
+    unique_ptr<TranspositionTable> tt;
+    if (tt_mb > 0) tt = make_unique<TranspositionTable>(tt_mb);
+    TranspositionTable* table = tt.get();
+    SearchOptions options;
+    options.table = table;
+    options.ordering = ordering;
+
+    // Table size and hit rate, on stderr so the solution output is unchanged
+    auto report_table = [&]() {
+        if (!table) return;
+        auto stats = table->stats();
+        cerr << "Transposition table: " << table->bytes() / (1024 * 1024) << " MB, " << table->capacity() << " entries, "
+             << stats.probes << " probes, " << stats.hits << " hits (" << fixed << setprecision(1)
+             << 100 * stats.hit_rate() << "%), " << stats.stores << " stores, " << stats.replacements << " replacements\n";
+    };
+
+    if (order != 0) {
+        switch (order) {
+            case 8: solve_empty_board<8>(engine, split, workers, options, stats); break;
+            case 9: solve_empty_board<9>(engine, split, workers, options, stats); break;
+            case 10: solve_empty_board<10>(engine, split, workers, options, stats); break;
+            case 11: solve_empty_board<11>(engine, split, workers, options, stats); break;
+            case 12: solve_empty_board<12>(engine, split, workers, options, stats); break;
+            default:
+                cerr << "Unsupported order " << order << " (expected 8 to 12)\n";
+                return 1;
+        }
+        report_table();
+        return 0;
+    }
+
+    if (count || enumerate) {
+        // Completions are written by the buffered writer only; print_grid stays off this path
+        SolutionWriter writer(stdout);
+        for (int g = 0; g < int(all_initial_tilings.size()); ++g) {
+            GridState state = initial_state(all_initial_tilings[g]);
+            SearchStats search_stats;
+            search_stats.grid = g + 1;
+            search_stats.report_every = 1.0;
+            SearchOptions grid_options = options;
+            if (stats) grid_options.stats = &search_stats;
+            search_stats.start();
+            uint64_t found = enumerate_solutions(state, [&](const GridState& solved, uint64_t index) {
+                if (enumerate) writer.write(g + 1, index, solved);
+            }, max_solutions, grid_options);
+            search_stats.finish();
+
+            if (enumerate) {
+                writer.flush();
+                cerr << "Grid " << g + 1 << ": " << found << (found == 1 ? " completion\n" : " completions\n");
+            } else {
+                cout << "Grid " << g + 1 << ": " << found << (found == 1 ? " completion (unique)\n" : " completions\n");
+            }
+            if (stats) cerr << search_stats.json(9) << "\n";
+        }
+        report_table();
+        return 0;
+    }
+
+    auto emit = [&](int g, const BatchResult& result) {
         // Print initial grid
         std::cout << "Initial tiling of grid " << g + 1 << ": \n";
-        print_grid(state);
+        print_grid(result.initial);
 
         // Print solved grid
-        if (solve_puzzle(state)) {
+        if (result.found) {
             cout << "\n Solved tiling grid " << g + 1 << ": \n";
-            print_grid(state);
+            print_grid(result.solved);
             std::cout << "\n";
         } else {
             cout << "No solution found for grid " << g + 1 << "\n";
-        } 
+        }
+        std::cout << std::flush;
+        if (stats) cerr << result.stats.json(9) << "\n";
+    };
 
+    if (portfolio > 0) {
+        // Race the portfolio on each grid in turn and say which configuration won
+        const vector<PortfolioConfig> configs = portfolio_configs(portfolio);
+        for (int g = 0; g < int(all_initial_tilings.size()); ++g) {
+            BatchResult result;
+            result.initial = initial_state(all_initial_tilings[g]);
+            result.solved = result.initial;
+            result.stats.grid = g + 1;
+            SearchOptions grid_options = options;
+            if (stats) {
+                grid_options.stats = &result.stats;
+                result.stats.start();
+            }
+            int winner = -1;
+            result.found = solve_portfolio(result.solved, configs, grid_options, &winner);
+            if (stats) result.stats.finish();
+            emit(g, result);
+            if (result.found) {
+                cerr << "Grid " << g + 1 << ": won by " << ordering_name(configs[winner].ordering) << " ordering on the "
+                     << symmetry_name(configs[winner].symmetry) << " board\n";
+            }
+        }
+    } else if (split && engine == Engine::Backtrack) {
+        for (int g = 0; g < int(all_initial_tilings.size()); ++g) {
+            BatchResult result;
+            result.initial = initial_state(all_initial_tilings[g]);
+            result.solved = result.initial;
+            result.stats.grid = g + 1;
+            result.found = solve_instance(result.solved, engine, true, workers, options, stats ? &result.stats : nullptr);
+            emit(g, result);
+        }
+    } else {
+        solve_batch(all_initial_tilings, workers, engine, options, stats, emit);
     }
+    report_table();
 
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,186 @@
+#include "search.hpp"
+#include "clues.hpp"
+#include <chrono>
+#include <random>
+#include <sstream>
+#include <iomanip>
+
+// Benchmarks for the Number Cross solver, one JSON object per line on stdout
+// Micro-benchmarks time the row kernels and every clue in ns/op over a fixed workload (random
+// grids from a fixed seed), best of --reps. The macro benchmark times one tile() search of fixed
+// region assignments with a fresh memo; its node counts and max rows are deterministic, so two
+// runs of the same commit must agree on them and a diff between commits shows search changes.
+
+// Region digits of the solved grid, and two assignments that fail after different amounts of search
+const std::vector<std::array<uint8_t, 9>> default_assignments = {
+    {2, 4, 3, 4, 1, 3, 6, 7, 7},
+    {2, 1, 6, 1, 5, 3, 2, 1, 1},
+    {2, 4, 3, 4, 1, 3, 6, 5, 1},
+};
+
+// Grids with random digits and a random legal tile layout per row
+std::vector<Grid> random_grids(int count) {
+    std::mt19937 rng(20250501);
+    std::vector<Grid> grids(count);
+    for (Grid& grid : grids) {
+        for (auto& digit : grid.digits) digit = uint8_t(1 + rng() % 9);
+        for (int row = 0; row < SIZE; ++row) {
+            const auto& candidates = tile_patterns.candidates(grid, row);
+            grid.tiles[row] = tile_patterns.patterns[row][candidates[rng() % candidates.size()]].mask;
+        }
+    }
+    return grids;
+}
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Nanoseconds per call of op(i) for i in [0, n), best of reps; sink keeps the results alive
+template <typename Op>
+double ns_per_op(int reps, size_t n, Op op) {
+    double best = -1;
+    volatile uint64_t sink = 0;
+    for (int r = 0; r < reps; ++r) {
+        uint64_t acc = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < n; ++i) acc += uint64_t(op(i));
+        const double ns = seconds_since(start) * 1e9 / double(n);
+        sink = sink + acc;
+        if (best < 0 || ns < best) best = ns;
+    }
+    return best;
+}
+
+void emit_micro(const std::string& name, double ns, size_t ops) {
+    std::cout << "{\"bench\":\"micro\",\"name\":\"" << name << "\",\"ops\":" << ops << ",\"ns_per_op\":" << std::fixed
+              << std::setprecision(2) << ns << "}\n";
+}
+
+void run_micro(int reps) {
+    const std::vector<Grid> grids = random_grids(20000);
+    const size_t rows = grids.size() * SIZE;
+    auto grid_of = [&](size_t i) -> const Grid& { return grids[i / SIZE]; };
+
+    emit_micro("extract_numbers", ns_per_op(reps, rows, [&](size_t i) {
+        return extract_numbers(grid_of(i), int(i % SIZE)).size();
+    }), rows);
+    emit_micro("hash_row", ns_per_op(reps, rows, [&](size_t i) {
+        return hash_row(grid_of(i), int(i % SIZE));
+    }), rows);
+    emit_micro("row_pair_key", ns_per_op(reps, grids.size() * (SIZE - 1), [&](size_t i) {
+        return row_pair_key(grids[i / (SIZE - 1)], int(i % (SIZE - 1))).words[0];
+    }), grids.size() * (SIZE - 1));
+
+    // validate_row_left at every column, against a handful of used numbers
+    UsedNumbers used;
+    for (int64_t n : {169, 2025, 4851, 11, 1597}) used.insert(n);
+    emit_micro("validate_row_left", ns_per_op(reps, rows * SIZE, [&](size_t i) {
+        return validate_row_left(grids[i / (SIZE * SIZE)], used, int(i / SIZE % SIZE), int(i % SIZE));
+    }), rows * SIZE);
+    emit_micro("validate_row", ns_per_op(reps, rows, [&](size_t i) {
+        return validate_row(grid_of(i), used, int(i % SIZE));
+    }), rows);
+
+    // Every clue over the numbers of the workload grids
+    std::vector<int64_t> numbers;
+    for (const Grid& grid : grids) {
+        for (int row = 0; row < SIZE; ++row) {
+            for (int64_t n : extract_numbers(grid, row)) numbers.push_back(n);
+        }
+    }
+    const size_t n = numbers.size();
+    auto clue = [&](const std::string& name, auto test) { emit_micro("clue_" + name, ns_per_op(reps, n, [&](size_t i) { return test(numbers[i]); }), n); };
+    clue("square", [](int64_t x) { return square(x); });
+    clue("product_of_digits_20", [](int64_t x) { return product_of_digits_is_m(x, 20); });
+    clue("multiple_of_13", [](int64_t x) { return multiple_of_m(x, 13); });
+    clue("multiple_of_32", [](int64_t x) { return multiple_of_m(x, 32); });
+    clue("divisible_by_every_digit", [](int64_t x) { return divisible_by_every_digit(x); });
+    clue("product_of_digits_25", [](int64_t x) { return product_of_digits_is_m(x, 25); });
+    clue("odd_palindrome", [](int64_t x) { return odd_palindrome(x); });
+    clue("fibonacci", [](int64_t x) { return fibonacci(x); });
+    clue("product_of_digits_2025", [](int64_t x) { return product_of_digits_is_m(x, 2025); });
+    clue("prime", [](int64_t x) { return prime(x); });
+
+    // The table lookups the search actually uses, one entry per row
+    for (int row = 0; row < CLUE_ROWS; ++row) {
+        emit_micro("clue_table_row_" + std::to_string(row), ns_per_op(reps, n, [&](size_t i) { return clue_tables.satisfies(row, numbers[i]); }), n);
+    }
+}
+
+// One tile() search of a fixed region assignment, with a fresh memo; best time of reps
+void run_macro(const std::array<uint8_t, 9>& digits, int reps, size_t memo_mb) {
+    double best = -1;
+    int max_row = -1;
+    int64_t nodes = 0;
+    Outcome outcome = Outcome::Refuted;
+    for (int r = 0; r < reps; ++r) {
+        RowPairMemo memo(memo_mb);
+        incompatible_pairs = &memo;
+        Grid grid;
+        for (int region = 0; region < 9; ++region) fill_region(grid, region, digits[region]);
+        NodeBudget budget(schedule.first_budget());
+        auto start = std::chrono::steady_clock::now();
+        outcome = try_assignment(grid, max_row, budget);
+        const double ms = seconds_since(start) * 1e3;
+        nodes = budget.used;
+        incompatible_pairs = nullptr;
+        if (best < 0 || ms < best) best = ms;
+    }
+
+    static const char* names[] = {"solved", "refuted", "abandoned", "cancelled"};
+    std::cout << "{\"bench\":\"macro\",\"digits\":\"";
+    for (int i = 0; i < 9; ++i) std::cout << (i ? " " : "") << int(digits[i]);
+    std::cout << "\",\"budget\":" << schedule.first_budget() << ",\"outcome\":\"" << names[int(outcome)] << "\",\"max_row\":" << max_row
+              << ",\"nodes\":" << nodes << ",\"ms\":" << std::fixed << std::setprecision(2) << best << "}\n";
+}
+
+bool parse_assignment(const std::string& text, std::array<uint8_t, 9>& digits) {
+    std::istringstream in(text);
+    for (auto& d : digits) {
+        int value;
+        if (!(in >> value) || value < 1 || value > 9) return false;
+        d = uint8_t(value);
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    // --micro / --macro: run only one kind (default both)
+    // --reps N: repetitions, the best is reported (default 5 micro, 1 macro)
+    // --assignment "d0 ... d8": macro benchmark of this region assignment instead of the defaults (repeatable)
+    // --budget N / --complete: node budget of the macro runs, as in the solver (default 60000)
+    // --memo-mb N: row pair memo size of the macro runs (default 64)
+    bool micro = true, macro = true;
+    int reps = 0;
+    size_t memo_mb = 64;
+    std::vector<std::array<uint8_t, 9>> assignments;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--micro") macro = false;
+        else if (arg == "--macro") micro = false;
+        else if (arg == "--reps" && i + 1 < argc) reps = std::max(1, std::stoi(argv[++i]));
+        else if (arg == "--budget" && i + 1 < argc) schedule.budget = std::max<int64_t>(1, std::stoll(argv[++i]));
+        else if (arg == "--complete") schedule.complete = true;
+        else if (arg == "--memo-mb" && i + 1 < argc) memo_mb = std::stoull(argv[++i]);
+        else if (arg == "--assignment" && i + 1 < argc) {
+            std::array<uint8_t, 9> digits;
+            if (!parse_assignment(argv[++i], digits)) {
+                std::cerr << "Expected nine digits 1-9, got \"" << argv[i] << "\"\n";
+                return 1;
+            }
+            assignments.push_back(digits);
+        }
+        else {
+            std::cerr << "Usage: " << argv[0] << " [--micro | --macro] [--reps N] [--assignment \"d0 ... d8\"] [--budget N] [--complete] [--memo-mb N]\n";
+            return 1;
+        }
+    }
+    if (assignments.empty()) assignments = default_assignments;
+
+    if (micro) run_micro(reps ? reps : 5);
+    if (macro) {
+        for (const auto& digits : assignments) run_macro(digits, reps ? reps : 1, memo_mb);
+    }
+    return 0;
+}
@@ -1,9 +1,9 @@
 #pragma once
 #include <cstdint>
 #include <vector>
-#include <functional>
 #include <unordered_set>
 #include <cmath>
+#include <algorithm>
 
 bool square(int64_t n);
 bool prime(int64_t n);
@@ -13,4 +13,199 @@ bool divisible_by_every_digit(int64_t n);
 bool multiple_of_m(int64_t n, int64_t m);
 bool odd_palindrome(int64_t n);
 
-extern std::vector<std::function<bool(int64_t)>> functions;
\ No newline at end of file
+// --------------------------------------------------------------------------------------------------------//
+// Clues as predicate types: Clue::test(n) checks one number, and test_batch(clue, numbers, count, out)
+// checks many at once. The simple clues are defined inline here so the search can inline them.
+// Clue::DIGITS has bit d set if digit d can appear in a number that satisfies the clue.
+
+namespace clue {
+
+constexpr uint16_t ANY_DIGIT = 0x3FF;
+
+// Nonzero digits that divide m
+constexpr uint16_t divisor_digits(int64_t m) {
+    uint16_t digits = 0;
+    for (int d = 1; d <= 9; ++d) if (m % d == 0) digits |= uint16_t(1 << d);
+    return digits;
+}
+
+struct Square {
+    static constexpr uint16_t DIGITS = ANY_DIGIT;
+
+    static bool test(int64_t n) {
+        int64_t root = int64_t(std::sqrt(double(n)));
+        while (root * root > n) --root;
+        while ((root + 1) * (root + 1) <= n) ++root;
+        return root * root == n;
+    }
+};
+
+template <int64_t M>
+struct ProductOfDigits {
+    static constexpr uint16_t DIGITS = divisor_digits(M);
+    static bool test(int64_t n) {
+        int64_t product = 1;
+        for (; n != 0; n /= 10) product *= n % 10;
+        return product == M;
+    }
+};
+
+template <int64_t M>
+struct MultipleOf {
+    static constexpr uint16_t DIGITS = ANY_DIGIT;
+    static bool test(int64_t n) { return n % M == 0; }
+};
+
+struct EveryDigitDivides {
+    static constexpr uint16_t DIGITS = ANY_DIGIT & ~1; // no zeros
+    static bool test(int64_t n) {
+        for (int64_t rest = n; rest != 0; rest /= 10) {
+            const int digit = int(rest % 10);
+            if (digit == 0 || n % digit != 0) return false;
+        }
+        return true;
+    }
+};
+
+struct OddPalindrome {
+    static constexpr uint16_t DIGITS = ANY_DIGIT;
+    static bool test(int64_t n) {
+        if (n % 2 == 0) return false;
+        int64_t reversed = 0;
+        for (int64_t rest = n; rest > 0; rest /= 10) reversed = reversed * 10 + rest % 10;
+        return reversed == n;
+    }
+};
+
+struct Fibonacci {
+    static constexpr uint16_t DIGITS = ANY_DIGIT;
+    static bool test(int64_t n) { return fibonacci(n); }
+};
+
+struct Prime {
+    static constexpr uint16_t DIGITS = ANY_DIGIT;
+    static bool test(int64_t n) { return prime(n); }
+};
+
+// Digits of up to 11-digit numbers, least significant first, with 10 marking positions past the
+// leading digit. The number is split into two halves below 2^31 so the per-digit divisions run on
+// 32-bit lanes, and every lane takes the same 11 steps, which lets the compiler vectorise the loop.
+inline void extract_digits(const int64_t* numbers, int count, uint8_t (*digits)[11]) {
+    static constexpr int64_t POW10[11] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000,
+                                          100000000, 1000000000, 10000000000};
+    for (int i = 0; i < count; ++i) {
+        const int64_t n = numbers[i];
+        uint32_t low = uint32_t(n % 1000000), high = uint32_t(n / 1000000);
+        for (int d = 0; d < 6; ++d, low /= 10) digits[i][d] = n >= POW10[d] ? uint8_t(low % 10) : 10;
+        for (int d = 6; d < 11; ++d, high /= 10) digits[i][d] = n >= POW10[d] ? uint8_t(high % 10) : 10;
+    }
+}
+
+// Generic batch: one test per number
+template <typename Clue>
+void test_batch(Clue, const int64_t* numbers, int count, uint8_t* out) {
+    for (int i = 0; i < count; ++i) out[i] = Clue::test(numbers[i]);
+}
+
+// Digit products from the batched digit extraction (past-the-end digits count as 1)
+template <int64_t M>
+void test_batch(ProductOfDigits<M>, const int64_t* numbers, int count, uint8_t* out) {
+    constexpr int BLOCK = 256;
+    uint8_t digits[BLOCK][11];
+    for (int start = 0; start < count; start += BLOCK) {
+        const int size = std::min(BLOCK, count - start);
+        extract_digits(numbers + start, size, digits);
+        for (int i = 0; i < size; ++i) {
+            int64_t product = 1;
+            for (int d = 0; d < 11; ++d) product *= digits[i][d] == 10 ? 1 : digits[i][d];
+            out[start + i] = product == M;
+        }
+    }
+}
+
+// Every digit divides n, again from the batched digit extraction
+inline void test_batch(EveryDigitDivides, const int64_t* numbers, int count, uint8_t* out) {
+    constexpr int BLOCK = 256;
+    uint8_t digits[BLOCK][11];
+    for (int start = 0; start < count; start += BLOCK) {
+        const int size = std::min(BLOCK, count - start);
+        extract_digits(numbers + start, size, digits);
+        for (int i = 0; i < size; ++i) {
+            const int64_t n = numbers[start + i];
+            bool ok = true;
+            for (int d = 0; d < 11; ++d) {
+                const int digit = digits[i][d];
+                ok &= digit != 0 && (digit == 10 || n % digit == 0);
+            }
+            out[start + i] = ok;
+        }
+    }
+}
+
+} // namespace clue
+
+// The clue of each row
+template <int Row> struct RowClue;
+template <> struct RowClue<0> { using type = clue::Square; };
+template <> struct RowClue<1> { using type = clue::ProductOfDigits<20>; };
+template <> struct RowClue<2> { using type = clue::MultipleOf<13>; };
+template <> struct RowClue<3> { using type = clue::MultipleOf<32>; };
+template <> struct RowClue<4> { using type = clue::EveryDigitDivides; };
+template <> struct RowClue<5> { using type = clue::ProductOfDigits<25>; };
+template <> struct RowClue<6> { using type = clue::EveryDigitDivides; };
+template <> struct RowClue<7> { using type = clue::OddPalindrome; };
+template <> struct RowClue<8> { using type = clue::Fibonacci; };
+template <> struct RowClue<9> { using type = clue::ProductOfDigits<2025>; };
+template <> struct RowClue<10> { using type = clue::Prime; };
+
+constexpr int CLUE_ROWS = 11;
+
+// Call f(clue) with the clue type of a row chosen at runtime
+template <typename F>
+decltype(auto) with_row_clue(int row, F f) {
+    switch (row) {
+        case 0: return f(RowClue<0>::type{});
+        case 1: return f(RowClue<1>::type{});
+        case 2: return f(RowClue<2>::type{});
+        case 3: return f(RowClue<3>::type{});
+        case 4: return f(RowClue<4>::type{});
+        case 5: return f(RowClue<5>::type{});
+        case 6: return f(RowClue<6>::type{});
+        case 7: return f(RowClue<7>::type{});
+        case 8: return f(RowClue<8>::type{});
+        case 9: return f(RowClue<9>::type{});
+        default: return f(RowClue<10>::type{});
+    }
+}
+
+// Does n satisfy the clue of row?
+inline bool check_clue(int row, int64_t n) {
+    return with_row_clue(row, [n](auto c) { return decltype(c)::test(n); });
+}
+
+// Digits that can appear in a number satisfying the clue of row (bit d = digit d)
+inline uint16_t row_digit_domain(int row) {
+    return with_row_clue(row, [](auto c) { return decltype(c)::DIGITS; });
+}
+
+// out[i] = whether numbers[i] satisfies the clue of row
+inline void check_clue_batch(int row, const int64_t* numbers, int count, uint8_t* out) {
+    with_row_clue(row, [&](auto c) { clue::test_batch(c, numbers, count, out); });
+}
+
+// --------------------------------------------------------------------------------------------------------//
+
+// Clue lookups for every row, built once at startup
+// Numbers below SMALL_LIMIT (up to 6 digits) are answered from one bitset per row. Larger numbers
+// are looked up in a sorted array for the rows whose clue admits few values (digit products and
+// fibonacci), and computed directly for the others (prime by deterministic Miller-Rabin).
+struct ClueTables {
+    static constexpr int64_t SMALL_LIMIT = 1000000;
+    std::vector<std::vector<bool>> small; // small[row][n]
+    std::vector<std::vector<int64_t>> sparse; // sparse[row]: every satisfying value with 2 to 11 digits
+
+    ClueTables();
+    bool satisfies(int row, int64_t n) const;
+};
+
+extern const ClueTables clue_tables;
@@ -0,0 +1,22 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include "grid.hpp"
+
+// Digit domains, built once at startup from the row clues
+// Every cell that is not a tile ends up as a digit of a number in its row, so its final digit must
+// be one the row's clue admits (bit d of cell[i] = digit d allowed). Digits only grow from the
+// region digit as tiles are distributed, so a cell whose digit already exceeds max_digit can never
+// get back into its domain, and a cell that can never be a tile (highlighted, or one cell from an
+// edge) rules out every region digit above its maximum.
+struct DigitDomains {
+    std::array<uint16_t, SIZE * SIZE> cell;
+    std::array<uint8_t, SIZE * SIZE> max_digit;
+    std::array<std::array<bool, 10>, 9> region_digit; // region_digit[region][value]: no fixed cell of region rules value out
+
+    DigitDomains();
+
+    bool allows(int index, int digit) const { return (cell[index] >> digit) & 1; }
+};
+
+extern const DigitDomains digit_domains;
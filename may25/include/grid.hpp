@@ -5,25 +5,58 @@
 #include <iostream>
 #include <cstdint>
 #include <unordered_set>
-
-struct Cell {
-    int digit = 0;  // Stores the cell's digit
-    bool highlight = false; // Highlighted cells-> no tiles, no increments
-    bool tile = false; 
-    std::vector<std::pair<int, int>> adjacent;  // Stores orthogonal neighbors
-    int row = 0; int col = 0; 
-    // Constructor
-    Cell(int val = 0) : digit(val) {} 
-};
-
-struct PairHash { 
-    size_t operator()(const std::pair<size_t, size_t>& p) const { 
-        return p.first ^ (p.second << 16); 
-    } 
+#include <array>
+#include <utility>
+
+// Numbers used by the rows completed so far
+// A row's numbers are added together once it is valid and removed together when the search
+// backtracks past it, so the set is kept as a stack that doubles as its own undo log:
+// take mark() before adding a row's numbers and rollback(mark) to remove them again.
+// The grid never holds more than a few dozen numbers, so a linear scan beats hashing.
+// contains() also remembers the lowest stack position it matched (the conflict), so a search can
+// tell whether a failure below some mark depended on the numbers added before it.
+class UsedNumbers {
+public:
+    static constexpr size_t NO_CONFLICT = SIZE_MAX;
+
+    UsedNumbers() { numbers.reserve(64); }
+
+    bool contains(int64_t n) const {
+        for (size_t i = 0; i < numbers.size(); ++i) {
+            if (numbers[i] == n) {
+                if (i < conflict) conflict = i;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void insert(int64_t n) { numbers.push_back(n); }
+    size_t mark() const { return numbers.size(); }
+    void rollback(size_t mark) { numbers.resize(mark); }
+
+    // Start tracking conflicts afresh, returning the conflict tracked so far
+    size_t take_conflict() {
+        const size_t outer = conflict;
+        conflict = NO_CONFLICT;
+        return outer;
+    }
+
+    // Lowest position matched since take_conflict()
+    size_t lowest_conflict() const { return conflict; }
+
+    // Fold the conflict returned by take_conflict() back in
+    void restore_conflict(size_t outer) {
+        if (outer < conflict) conflict = outer;
+    }
+
+private:
+    std::vector<int64_t> numbers;
+    mutable size_t conflict = NO_CONFLICT;
 };
 
 // --------------------------------------------------------------------------------------------------------//
-using Grid = std::vector<std::vector<Cell>>;
+constexpr int SIZE = 11; // the grid is SIZE x SIZE
 
 // Coordinates of cells in each region 
 const std::vector<std::vector<std::pair<int,int>>> region_coords = {
@@ -62,11 +95,65 @@ const std::vector<std::vector<std::pair<int,int>>> region_coords = {
 };
 
 // Store highlighted (constant) cells as coordinates
-const std::vector<std::pair<int,int>> highlighted_coords = {
+constexpr std::pair<int,int> highlighted_coords[] = {
     {1,3}, {1,4}, {2,4}, {2,9}, {3,8}, {3,9}, {5,5},
     {6,1}, {6,2}, {6,5}, {6,6}, {7,1}, {7,5}, {8,4}, {8,5}, {9,4}
 };
 
+// Highlighted cells as one bitmask per row (bit c = column c)
+constexpr std::array<uint16_t, SIZE> make_highlight_masks() {
+    std::array<uint16_t, SIZE> masks{};
+    for (auto c : highlighted_coords) masks[c.first] |= uint16_t(1 << c.second);
+    return masks;
+}
+constexpr std::array<uint16_t, SIZE> HIGHLIGHT_MASKS = make_highlight_masks();
+
+// Orthogonal neighbours of each cell (index r * SIZE + c), in the order up, down, left, right
+struct Neighbours {
+    int count = 0;
+    std::array<uint8_t, 4> cells{};
+};
+constexpr std::array<Neighbours, SIZE * SIZE> make_adjacency() {
+    std::array<Neighbours, SIZE * SIZE> adjacency{};
+    for (int r = 0; r < SIZE; ++r) {
+        for (int c = 0; c < SIZE; ++c) {
+            Neighbours& n = adjacency[r * SIZE + c];
+            if (r > 0) n.cells[n.count++] = uint8_t((r - 1) * SIZE + c);        // Up
+            if (r < SIZE - 1) n.cells[n.count++] = uint8_t((r + 1) * SIZE + c); // Down
+            if (c > 0) n.cells[n.count++] = uint8_t(r * SIZE + c - 1);          // Left
+            if (c < SIZE - 1) n.cells[n.count++] = uint8_t(r * SIZE + c + 1);   // Right
+        }
+    }
+    return adjacency;
+}
+constexpr std::array<Neighbours, SIZE * SIZE> ADJACENT = make_adjacency();
+
+// The grid: one digit byte per cell and one tile bitmask per row (143 bytes in all), so copying
+// the whole grid touches three cache lines and a row's digits are 11 contiguous bytes
+struct Grid {
+    std::array<uint8_t, SIZE * SIZE> digits{}; // digits[r * SIZE + c]
+    std::array<uint16_t, SIZE> tiles{};        // bit c of tiles[r] set = tile at (r, c)
+
+    uint8_t& digit(int r, int c) { return digits[r * SIZE + c]; }
+    uint8_t digit(int r, int c) const { return digits[r * SIZE + c]; }
+    bool tile(int r, int c) const { return (tiles[r] >> c) & 1; }
+    void set_tile(int r, int c) { tiles[r] |= uint16_t(1 << c); }
+    void clear_tile(int r, int c) { tiles[r] &= uint16_t(~(1 << c)); }
+    static bool highlight(int r, int c) { return (HIGHLIGHT_MASKS[r] >> c) & 1; } // Highlighted cells-> no tiles, no increments
+};
+
+// The numbers of a row, left to right (a row of SIZE cells holds at most SIZE / 2 + 1 of them)
+struct RowNumbers {
+    std::array<int64_t, SIZE / 2 + 1> values{};
+    int count = 0;
+
+    void push_back(int64_t n) { values[count++] = n; }
+    int size() const { return count; }
+    int64_t operator[](int i) const { return values[i]; }
+    const int64_t* begin() const { return values.data(); }
+    const int64_t* end() const { return values.data() + count; }
+};
+
 // Region constraints: region A cannot equal region B (adjacent regions cannot have same digit)
 const std::vector<std::vector<int>> region_dependencies = { 
     {}, // Region 0: no dependencies 
@@ -84,21 +171,18 @@ const std::vector<std::vector<int>> region_dependencies = {
 // --------------------------------------------------------------------------------------------------------//
 
 // Hash row of grid for memoization
-size_t hash_row(const std::vector<Cell>& row);
+size_t hash_row(const Grid& grid, int row);
 
-// Extract numbers from row, ignoring tiles
-std::vector<int64_t> extract_numbers(const std::vector<Cell>& row);
+// Extract numbers from cells [0, end) of row, ignoring tiles
+RowNumbers extract_numbers(const Grid& grid, int row, int end = SIZE);
 
 // Print grid with highlights as green and tiles as X
 const std::string GREEN = "\033[32m";
 const std::string RESET = "\033[0m";
 void print_grid(const Grid& grid);
 
-// Set up grid (adjacent cells, highlighted cells, row and col)
-void set_up_grid(Grid& grid);
-
 // Do the numbers in the row satisfy the clue? Are there duplicate numbers? 
-bool validate_row(const Grid& grid, std::unordered_set<int64_t> used_numbers, int row);
+bool validate_row(const Grid& grid, const UsedNumbers& used_numbers, int row);
 
 // Are indexes [0,..,col] of row valid? 
-bool validate_row_left(const Grid& grid, std::unordered_set<int64_t> used_numbers, int row, int col);
\ No newline at end of file
+bool validate_row_left(const Grid& grid, const UsedNumbers& used_numbers, int row, int col);
\ No newline at end of file
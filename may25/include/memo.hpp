@@ -0,0 +1,85 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <mutex>
+#include <unordered_set>
+#include "grid.hpp"
+
+// Key for "row + 1 cannot be completed below row": rows row and row + 1 packed in full (4 bits
+// per digit, 11 tile bits, plus the row index) and the digits of every region that has a cell in
+// a later row, since those are the digits the rest of the search will see. Regions that only
+// appear in earlier rows are left out, so a failure found under one region assignment is reused
+// under the others that agree on the rows involved. The numbers used above the pair are not part
+// of the key either: the search only stores failures in which no number was rejected as a
+// duplicate of one of them (see UsedNumbers::take_conflict).
+struct RowPairKey {
+    uint64_t words[3];
+
+    bool operator==(const RowPairKey& other) const {
+        return words[0] == other.words[0] && words[1] == other.words[1] && words[2] == other.words[2];
+    }
+};
+
+RowPairKey row_pair_key(const Grid& grid, int row);
+
+// --------------------------------------------------------------------------------------------------------//
+
+// Fixed-size open-addressing table of row pairs known to fail
+// A key may live in any of the PROBE slots after its home slot. Hits set the slot's reference bit.
+// When every slot in the window is taken, a clock hand sweeps the window clearing reference bits
+// and evicts the first slot that was not used since the last sweep, which approximates LRU
+// without keeping timestamps.
+class RowPairMemo {
+public:
+    struct Stats {
+        uint64_t probes, hits, stores, evictions;
+        double hit_rate() const { return probes ? double(hits) / double(probes) : 0.0; }
+    };
+
+    // Size the table to the largest power-of-two slot count within megabytes (at least PROBE slots)
+    explicit RowPairMemo(size_t megabytes);
+
+    // A failed pair is stored with the deepest row validated below it; a hit raises max_row to that
+    // row, as if the failed search had run again
+    bool contains(const RowPairKey& key, int& max_row);
+    void insert(const RowPairKey& key, int max_row);
+
+    Stats stats() const { return {probes, hits, stores, evictions}; }
+    size_t capacity() const { return slots.size(); }
+    size_t bytes() const { return slots.size() * sizeof(Slot); }
+
+private:
+    static constexpr int PROBE = 8;
+    static constexpr uint32_t USED = 1, REFERENCED = 2;
+
+    struct Slot {
+        RowPairKey key;
+        uint32_t flags = 0;
+        int32_t max_row = -1; // deepest row validated below the pair
+    };
+
+    size_t home(const RowPairKey& key) const;
+
+    std::vector<Slot> slots;
+    size_t mask = 0;
+    int hand = 0; // clock position within a probe window
+    uint64_t probes = 0, hits = 0, stores = 0, evictions = 0;
+};
+
+// --------------------------------------------------------------------------------------------------------//
+
+// Region assignments whose tile() search failed, shared by the parallel workers
+// A failure whose last max row was m is recorded by the digits of the regions with a cell in rows
+// 0..m + 2. Any later assignment with the same digits there has the same first m + 3 rows, which
+// is the serial search's last_grid test, but checked against every failure so far instead of only
+// the previous one.
+class FailedAssignments {
+public:
+    bool covers(const Grid& grid) const;
+    void add(const Grid& grid, int max_row);
+
+private:
+    mutable std::mutex m;
+    std::unordered_set<uint64_t> keys[SIZE + 1]; // keys[max_row + 1]
+};
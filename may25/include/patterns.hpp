@@ -0,0 +1,33 @@
+#pragma once
+#include <vector>
+#include <array>
+#include <cstdint>
+#include "grid.hpp"
+
+// Columns of the tiles in a row, left to right
+struct RowTiles {
+    uint16_t mask = 0;
+    std::array<int, SIZE> cols;
+    int count = 0;
+};
+
+// Every legal tile layout of each row, built once at startup
+// A layout is legal if no tile is on a highlighted cell or one cell from either edge (which would
+// leave a single digit number), and any two tiles have at least two digits between them. Layouts
+// are listed in the order the cell-by-cell search used to reach them (no tile before tile, from
+// the left). compatible[row][i] lists, in the same order, the layouts of row that put no tile
+// directly under layout i of row - 1; row 0 has a single list holding all its layouts.
+struct TilePatterns {
+    std::vector<RowTiles> patterns[SIZE];
+    std::vector<std::vector<uint16_t>> compatible[SIZE];
+    std::array<int16_t, 1 << SIZE> index[SIZE]; // index[row][mask] = position in patterns[row], -1 if illegal
+
+    TilePatterns();
+
+    // Layouts of row allowed under the tiles already placed in the row above
+    const std::vector<uint16_t>& candidates(const Grid& grid, int row) const {
+        return compatible[row][row == 0 ? 0 : index[row - 1][grid.tiles[row - 1]]];
+    }
+};
+
+extern const TilePatterns tile_patterns;
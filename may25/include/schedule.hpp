@@ -0,0 +1,74 @@
+#pragma once
+#include <vector>
+#include <array>
+#include <mutex>
+#include <cstdint>
+#include <limits>
+
+constexpr int64_t UNLIMITED = std::numeric_limits<int64_t>::max();
+
+// Node budget of one tile() search, counted in validated rows
+// A search that goes over its limit is abandoned: it has not shown that the assignment fails.
+struct NodeBudget {
+    int64_t limit;
+    int64_t used = 0;
+
+    explicit NodeBudget(int64_t limit) : limit(limit) {}
+    bool exhausted() const { return used > limit; }
+};
+
+// How region assignments are budgeted
+// Every assignment first gets `budget` nodes. With restarts, assignments abandoned at their budget
+// are revisited in rounds, round r allowing budget * luby(r) nodes; the search is deterministic, so a
+// round whose budget is no larger than one already tried is skipped, and the rounds escalate until
+// every abandoned assignment is solved or refuted. Complete mode drops the budget altogether, and
+// with it the skipping of assignments that look like an earlier failure.
+struct ScheduleOptions {
+    int64_t budget = 60000;
+    bool restarts = false;
+    bool complete = false;
+
+    int64_t first_budget() const { return complete ? UNLIMITED : budget; }
+
+    // Budget of restart round r (r >= 2), saturating at UNLIMITED
+    int64_t round_budget(int64_t r) const {
+        const int64_t factor = luby(r);
+        return budget > UNLIMITED / factor ? UNLIMITED : budget * factor;
+    }
+
+    // Luby sequence 1, 1, 2, 1, 1, 2, 4, 1, 1, 2, 1, 1, 2, 4, 8, ... for i = 1, 2, ...
+    static int64_t luby(int64_t i) {
+        while (true) {
+            int k = 1;
+            while ((int64_t(1) << k) - 1 < i) ++k; // smallest k with i <= 2^k - 1
+            if (i == (int64_t(1) << k) - 1) return int64_t(1) << (k - 1);
+            i -= (int64_t(1) << (k - 1)) - 1;
+        }
+    }
+};
+
+// Region digits of the assignments abandoned at their budget, waiting for a restart round
+class AbandonedAssignments {
+public:
+    void add(const std::array<uint8_t, 9>& digits) {
+        std::lock_guard<std::mutex> lock(m);
+        pending.push_back(digits);
+    }
+
+    bool empty() {
+        std::lock_guard<std::mutex> lock(m);
+        return pending.empty();
+    }
+
+    // Hand over everything recorded so far
+    std::vector<std::array<uint8_t, 9>> take() {
+        std::lock_guard<std::mutex> lock(m);
+        std::vector<std::array<uint8_t, 9>> out;
+        out.swap(pending);
+        return out;
+    }
+
+private:
+    std::mutex m;
+    std::vector<std::array<uint8_t, 9>> pending;
+};
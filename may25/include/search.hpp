@@ -0,0 +1,58 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include "grid.hpp"
+#include "memo.hpp"
+#include "patterns.hpp"
+#include "schedule.hpp"
+#include "telemetry.hpp"
+
+// Memoization table of row pairs known to fail, kept across region assignments (one per worker thread)
+extern thread_local RowPairMemo* incompatible_pairs;
+
+// Set once any worker has found the solution; every running tile() search then unwinds
+extern std::atomic<bool> cancelled;
+
+// Node budgets per region assignment, and the assignments waiting for a restart round
+extern ScheduleOptions schedule;
+extern AbandonedAssignments abandoned;
+
+// Whether search threads record telemetry (--telemetry, in builds with NUMBERCROSS_TELEMETRY=1)
+extern bool record_telemetry;
+
+// --------------------------------------------------------------------------------------------------------//
+
+// Try incrementing the row given tile placement
+bool increment(Grid& grid, const RowTiles& tiles, int row, int& max_row, UsedNumbers& used_numbers, int index, NodeBudget& budget);
+
+// Try tile placement: each legal layout of the row, given the tiles in the row above
+bool tile(Grid& grid, int row, int& max_row, UsedNumbers& used_numbers, NodeBudget& budget);
+
+// Is value allowed for region, given the regions it must differ from and the digit domains?
+bool region_value_allowed(const Grid& grid, int region, int value);
+
+void fill_region(Grid& grid, int region, int value);
+std::array<uint8_t, 9> region_digits(const Grid& grid);
+
+// How the tile search of one region assignment ended
+enum class Outcome { Solved, Refuted, Abandoned, Cancelled };
+
+// Run the tile search for a complete region assignment within budget (recorded by the thread's
+// telemetry, if any); max_row receives the last valid row. Needs incompatible_pairs to be set.
+Outcome try_assignment(Grid& grid, int& max_row, NodeBudget& budget);
+
+// Output a failed digit assignment and the share of its budget it used
+void print_failed_assignment(const Grid& grid, int max_row, const NodeBudget& budget);
+
+// Find original digit assignment to regions
+bool find_digits(Grid& grid, int region, Grid& last_grid, int& last_max_row);
+
+// Region assignments split across `workers` threads, each with its own grid, used numbers and row
+// pair memo (memo_mb / workers megabytes each); on success grid holds the solved grid
+bool find_digits_parallel(Grid& grid, int workers, size_t memo_mb, int split_depth = 4);
+
+// Restart rounds: revisit the abandoned assignments with escalating budgets until each is solved or
+// refuted; on success grid holds the solved grid
+bool restart_abandoned(Grid& grid, int workers, size_t memo_mb);
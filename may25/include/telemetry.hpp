@@ -0,0 +1,145 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <algorithm>
+#include "grid.hpp"
+
+// Search telemetry is compiled in only when building with -DNUMBERCROSS_TELEMETRY=1. Otherwise
+// every probe below is an empty inline call and the counters are never touched.
+#ifndef NUMBERCROSS_TELEMETRY
+#define NUMBERCROSS_TELEMETRY 0
+#endif
+constexpr bool TELEMETRY_ENABLED = NUMBERCROSS_TELEMETRY != 0;
+
+// Instrumented search functions
+enum class Probe { Tile, Increment, Distribute, ValidateRow, ValidateRowLeft, Count };
+
+// Why a branch was cut, counted per row
+enum class Prune { ValidateRow, ValidateRowLeft, Memo, Domain, Capacity, Count };
+
+// Counters of one search thread, written out as JSON lines on stderr: one record per region
+// assignment (then reset) and a heartbeat with the node rate every report_every seconds
+// Probe times are self times: a call's time excludes the probed calls made inside it, so the
+// recursive functions are not counted once per level and the times add up to the total.
+struct Telemetry {
+    int worker = 0;
+    double report_every = 1.0;
+
+    std::array<uint64_t, int(Probe::Count)> calls{};
+    std::array<uint64_t, int(Probe::Count)> nanos{}; // self time
+    std::array<std::array<uint64_t, SIZE>, int(Prune::Count)> prunes{};
+    uint64_t memo_hits = 0, memo_misses = 0;
+    uint64_t nodes = 0;       // validated rows in the current assignment
+    uint64_t total_nodes = 0; // validated rows since the thread started
+
+    explicit Telemetry(int worker);
+
+    void prune(Prune reason, int row) { ++prunes[int(reason)][row]; }
+
+    void node() {
+        ++nodes;
+        ++total_nodes;
+    }
+
+    // Called on every probed call; checks whether a heartbeat is due every 65536 calls
+    void tick() {
+        if ((++ticks & 65535) == 0) heartbeat();
+    }
+
+    uint64_t child_nanos = 0; // time of the probed calls inside the current one
+
+    void begin_assignment();
+    void end_assignment(const std::string& digits, const char* outcome, int max_row);
+
+private:
+    std::chrono::steady_clock::time_point start, assignment_start, last_report;
+    uint64_t last_nodes = 0;
+    uint64_t ticks = 0;
+
+    void heartbeat();
+};
+
+// The calling thread's telemetry, or null when it is not being recorded
+extern thread_local Telemetry* telemetry;
+
+// Times one call of a probed function for as long as it is in scope
+class ScopedProbe {
+public:
+    explicit ScopedProbe(Probe probe) {
+        if constexpr (TELEMETRY_ENABLED) {
+            if (!telemetry) return;
+            this->probe = probe;
+            ++telemetry->calls[int(probe)];
+            telemetry->tick();
+            outer_child_nanos = telemetry->child_nanos;
+            telemetry->child_nanos = 0;
+            begin = std::chrono::steady_clock::now();
+            active = true;
+        }
+    }
+
+    ~ScopedProbe() {
+        if constexpr (TELEMETRY_ENABLED) {
+            if (!active) return;
+            const uint64_t elapsed = uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count());
+            telemetry->nanos[int(probe)] += elapsed - std::min(elapsed, telemetry->child_nanos);
+            telemetry->child_nanos = outer_child_nanos + elapsed;
+        }
+    }
+
+    ScopedProbe(const ScopedProbe&) = delete;
+    ScopedProbe& operator=(const ScopedProbe&) = delete;
+
+private:
+    Probe probe = Probe::Tile;
+    bool active = false;
+    uint64_t outer_child_nanos = 0;
+    std::chrono::steady_clock::time_point begin;
+};
+
+// Count a pruned branch (no-op unless telemetry is compiled in and recording)
+inline void count_prune(Prune reason, int row) {
+    if constexpr (TELEMETRY_ENABLED) {
+        if (telemetry) telemetry->prune(reason, row);
+    }
+}
+
+// Count a row pair memo lookup
+inline void count_memo(bool hit) {
+    if constexpr (TELEMETRY_ENABLED) {
+        if (telemetry) ++(hit ? telemetry->memo_hits : telemetry->memo_misses);
+    }
+}
+
+// Count a validated row
+inline void count_node() {
+    if constexpr (TELEMETRY_ENABLED) {
+        if (telemetry) telemetry->node();
+    }
+}
+
+// Record on the calling thread for as long as it is in scope, if enabled
+class TelemetryScope {
+public:
+    TelemetryScope(bool enabled, int worker) {
+        if constexpr (TELEMETRY_ENABLED) {
+            if (!enabled) return;
+            owned = new Telemetry(worker);
+            telemetry = owned;
+        }
+    }
+
+    ~TelemetryScope() {
+        if (!owned) return;
+        telemetry = nullptr;
+        delete owned;
+    }
+
+    TelemetryScope(const TelemetryScope&) = delete;
+    TelemetryScope& operator=(const TelemetryScope&) = delete;
+
+private:
+    Telemetry* owned = nullptr;
+};
@@ -1,11 +1,10 @@
 #include "clues.hpp"
+#include <functional>
 
 
-// CLUES FOR EACH ROW
-bool square(int64_t n){
- int64_t root = int64_t(std::sqrt(n));
- return (root * root == n);
-}
+// CLUES FOR EACH ROW (square, divisible_by_every_digit and odd_palindrome forward to the
+// predicate types in clues.hpp, which the search uses directly)
+bool square(int64_t n){ return clue::Square::test(n); }
 
 bool product_of_digits_is_m(int64_t n, int64_t m){
  int64_t product = 1;
@@ -21,57 +20,100 @@ bool multiple_of_m(int64_t n, int64_t m){
  return (n % m == 0);
 }
 
-bool divisible_by_every_digit(int64_t n){
- int64_t original = n;
- int64_t temp = original;
- while (temp != 0){
-  int digit = temp % 10;
-  if (digit == 0 || original % digit != 0) return false;
-  temp /= 10;
- }
- return true;
-}
+bool divisible_by_every_digit(int64_t n){ return clue::EveryDigitDivides::test(n); }
 
-bool odd_palindrome(int64_t n){
-if (n % 2 == 0) return 0;
- int64_t original = n;
- int64_t reversed = 0;
- while (n > 0) {
-  reversed = reversed * 10 + n % 10;
-  n /= 10;
- }
- return (original == reversed);
+bool odd_palindrome(int64_t n){ return clue::OddPalindrome::test(n); }
+
+// Fibonacci numbers with 2 to 11 digits, in increasing order
+static std::vector<int64_t> fibonacci_table() {
+    std::vector<int64_t> table;
+    for (int64_t a = 1, b = 2; a < 100000000000; b += a, a = b - a) {
+        if (a >= 10) table.push_back(a);
+    }
+    return table;
 }
 
 bool fibonacci(int64_t n) {
-    std::unordered_set<int64_t> fibonacci_numbers = { // up to 5 digits 
-        13, 21, 34, 55, 89, 
-        144, 233, 377, 610, 987, 
-        1597, 2584, 4181, 6765,
-        10946,  17711, 28657, 46368, 75025
-    };
-    if (fibonacci_numbers.find(n) != fibonacci_numbers.end()) return true; 
-    else return false;
+    static const std::vector<int64_t> fibonacci_numbers = fibonacci_table();
+    return std::binary_search(fibonacci_numbers.begin(), fibonacci_numbers.end(), n);
+}
+
+// a^e mod m without overflow (m < 2^63)
+static uint64_t power_mod(uint64_t a, uint64_t e, uint64_t m) {
+    uint64_t result = 1;
+    a %= m;
+    while (e > 0) {
+        if (e & 1) result = uint64_t((unsigned __int128)result * a % m);
+        a = uint64_t((unsigned __int128)a * a % m);
+        e >>= 1;
+    }
+    return result;
 }
 
+// Deterministic Miller-Rabin: the bases 2..17 decide every n below 3.4 * 10^14
 bool prime(int64_t n){
- if (n == 2) return true;
- if (n % 2 == 0) return false;
- for (int64_t i = 3; i <= int64_t(std::sqrt(n)); i += 2) if (n % i == 0) return false;
- return true;
+    if (n < 2) return false;
+    for (int64_t p : {2, 3, 5, 7, 11, 13, 17}) {
+        if (n % p == 0) return n == p;
+    }
+    uint64_t d = uint64_t(n - 1);
+    int r = 0;
+    while ((d & 1) == 0) { d >>= 1; ++r; }
+    for (uint64_t a : {2, 3, 5, 7, 11, 13, 17}) {
+        uint64_t x = power_mod(a, d, uint64_t(n));
+        if (x == 1 || x == uint64_t(n - 1)) continue;
+        bool composite = true;
+        for (int i = 1; i < r && composite; ++i) {
+            x = uint64_t((unsigned __int128)x * x % uint64_t(n));
+            if (x == uint64_t(n - 1)) composite = false;
+        }
+        if (composite) return false;
+    }
+    return true;
 }
 
-// functions[r](n) returns whether the number n fulfills the clue of row r
-std::vector<std::function<bool(int64_t)>> functions = {
-    [](int64_t n) { return square(n); },
-    [](int64_t n) { return product_of_digits_is_m(n, 20); },
-    [](int64_t n) { return multiple_of_m(n, 13); },
-    [](int64_t n) { return multiple_of_m(n, 32); },
-    [](int64_t n) { return divisible_by_every_digit(n); },
-    [](int64_t n) { return product_of_digits_is_m(n, 25); },
-    [](int64_t n) { return divisible_by_every_digit(n); },
-    [](int64_t n) { return odd_palindrome(n); },
-    [](int64_t n) { return fibonacci(n); },
-    [](int64_t n) { return product_of_digits_is_m(n, 2025); },
-    [](int64_t n) { return prime(n); }
-}; 
+// --------------------------------------------------------------------------------------------------------//
+// Clue tables
+
+// Every number with 2 to 11 digits whose digit product is m (digits are 1..9, so no zeros)
+static std::vector<int64_t> product_table(int64_t m) {
+    std::vector<int64_t> table;
+    std::function<void(int64_t, int64_t, int)> extend = [&](int64_t n, int64_t product, int digits) {
+        if (product == m && digits >= 2) table.push_back(n);
+        if (digits == 11) return;
+        for (int d = 1; d <= 9; ++d) {
+            if ((m / product) % d == 0) extend(n * 10 + d, product * d, digits + 1);
+        }
+    };
+    extend(0, 1, 0);
+    std::sort(table.begin(), table.end());
+    return table;
+}
+
+ClueTables::ClueTables() : small(CLUE_ROWS, std::vector<bool>(SMALL_LIMIT)), sparse(CLUE_ROWS) {
+    // Every number below SMALL_LIMIT, tested a block at a time with the batch API
+    constexpr int BLOCK = 4096;
+    std::vector<int64_t> numbers(BLOCK);
+    std::vector<uint8_t> results(BLOCK);
+    for (int row = 0; row < CLUE_ROWS; ++row) {
+        for (int64_t start = 1; start < SMALL_LIMIT; start += BLOCK) {
+            const int count = int(std::min<int64_t>(BLOCK, SMALL_LIMIT - start));
+            for (int i = 0; i < count; ++i) numbers[i] = start + i;
+            check_clue_batch(row, numbers.data(), count, results.data());
+            for (int i = 0; i < count; ++i) small[row][start + i] = results[i];
+        }
+    }
+    sparse[1] = product_table(20);
+    sparse[5] = product_table(25);
+    sparse[8] = fibonacci_table();
+    sparse[9] = product_table(2025);
+}
+
+bool ClueTables::satisfies(int row, int64_t n) const {
+    if (n < SMALL_LIMIT) return small[row][n];
+    if (!sparse[row].empty()) return std::binary_search(sparse[row].begin(), sparse[row].end(), n);
+    return check_clue(row, n);
+}
+
+const ClueTables clue_tables;
+
@@ -0,0 +1,28 @@
+#include "domains.hpp"
+#include "clues.hpp"
+
+DigitDomains::DigitDomains() {
+    for (int r = 0; r < SIZE; ++r) {
+        const uint16_t domain = row_digit_domain(r);
+        int largest = 0;
+        for (int d = 0; d <= 9; ++d) if (domain >> d & 1) largest = d;
+        for (int c = 0; c < SIZE; ++c) {
+            cell[r * SIZE + c] = domain;
+            max_digit[r * SIZE + c] = uint8_t(largest);
+        }
+    }
+
+    for (int region = 0; region < int(region_coords.size()); ++region) {
+        for (int value = 0; value <= 9; ++value) {
+            bool allowed = true;
+            for (auto c : region_coords[region]) {
+                const int index = c.first * SIZE + c.second;
+                if (Grid::highlight(c.first, c.second)) allowed &= allows(index, value); // never changes
+                else if (c.second == 1 || c.second == SIZE - 2) allowed &= value <= max_digit[index]; // never a tile, can only grow
+            }
+            region_digit[region][value] = allowed;
+        }
+    }
+}
+
+const DigitDomains digit_domains;
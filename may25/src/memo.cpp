@@ -0,0 +1,135 @@
+#include "memo.hpp"
+#include <algorithm>
+
+// Bit k of regions_from(row) is set if region k has a cell in row or a later row
+static uint16_t regions_from(int row) {
+    static const std::vector<uint16_t> masks = [] {
+        std::vector<uint16_t> m(SIZE + 2, 0);
+        for (int k = 0; k < int(region_coords.size()); ++k) {
+            for (auto c : region_coords[k]) {
+                for (int r = 0; r <= c.first; ++r) m[r] |= uint16_t(1 << k);
+            }
+        }
+        return m;
+    }();
+    return masks[row];
+}
+
+// Bit k of regions_through(row) is set if region k has a cell in row or an earlier row
+static uint16_t regions_through(int row) {
+    static const std::vector<uint16_t> masks = [] {
+        std::vector<uint16_t> m(SIZE, 0);
+        for (int k = 0; k < int(region_coords.size()); ++k) {
+            for (auto c : region_coords[k]) {
+                for (int r = c.first; r < SIZE; ++r) m[r] |= uint16_t(1 << k);
+            }
+        }
+        return m;
+    }();
+    return masks[std::min(row, SIZE - 1)];
+}
+
+// Digits of the regions in mask, 4 bits per region
+static uint64_t pack_regions(const Grid& grid, uint16_t mask) {
+    uint64_t packed = 0;
+    for (int k = 0; k < int(region_coords.size()); ++k) {
+        if (mask >> k & 1) packed |= uint64_t(grid.digit(region_coords[k][0].first, region_coords[k][0].second)) << (4 * k);
+    }
+    return packed;
+}
+
+// Digits of row in 4-bit fields followed by the tile mask (55 bits)
+static uint64_t pack_row(const Grid& grid, int row) {
+    uint64_t packed = 0;
+    for (int c = 0; c < SIZE; ++c) packed = packed << 4 | grid.digit(row, c);
+    return packed << SIZE | grid.tiles[row];
+}
+
+RowPairKey row_pair_key(const Grid& grid, int row) {
+    RowPairKey key;
+    key.words[0] = pack_row(grid, row) << 4 | uint64_t(row);
+    key.words[1] = pack_row(grid, row + 1);
+    key.words[2] = pack_regions(grid, regions_from(row + 2));
+    return key;
+}
+
+// --------------------------------------------------------------------------------------------------------//
+
+RowPairMemo::RowPairMemo(size_t megabytes) {
+    size_t count = PROBE;
+    while (count * 2 * sizeof(Slot) <= megabytes * 1024 * 1024) count *= 2;
+    slots = std::vector<Slot>(count);
+    mask = count - 1;
+}
+
+// splitmix64 finaliser: every input bit reaches every output bit
+static uint64_t mix(uint64_t h) {
+    h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ull;
+    h = (h ^ (h >> 27)) * 0x94D049BB133111EBull;
+    return h ^ (h >> 31);
+}
+
+size_t RowPairMemo::home(const RowPairKey& key) const {
+    return size_t(mix(mix(mix(key.words[0]) ^ key.words[1]) ^ key.words[2])) & mask;
+}
+
+bool RowPairMemo::contains(const RowPairKey& key, int& max_row) {
+    ++probes;
+    const size_t start = home(key);
+    for (int i = 0; i < PROBE; ++i) {
+        Slot& slot = slots[(start + i) & mask];
+        if ((slot.flags & USED) && slot.key == key) {
+            slot.flags |= REFERENCED;
+            if (slot.max_row > max_row) max_row = slot.max_row;
+            ++hits;
+            return true;
+        }
+    }
+    return false;
+}
+
+void RowPairMemo::insert(const RowPairKey& key, int max_row) {
+    ++stores;
+    const size_t start = home(key);
+    Slot* empty = nullptr;
+    for (int i = 0; i < PROBE; ++i) {
+        Slot& slot = slots[(start + i) & mask];
+        if (!(slot.flags & USED)) {
+            if (!empty) empty = &slot;
+        }
+        else if (slot.key == key) {
+            slot.flags |= REFERENCED; // already known
+            if (max_row > slot.max_row) slot.max_row = int32_t(max_row);
+            return;
+        }
+    }
+
+    if (!empty) { // window full: sweep it with the clock hand
+        while (true) {
+            Slot& slot = slots[(start + hand) & mask];
+            hand = (hand + 1) % PROBE;
+            if (slot.flags & REFERENCED) slot.flags &= ~REFERENCED; // second chance
+            else { empty = &slot; break; }
+        }
+        ++evictions;
+    }
+    empty->key = key;
+    empty->flags = USED | REFERENCED;
+    empty->max_row = int32_t(max_row);
+}
+
+// --------------------------------------------------------------------------------------------------------//
+
+bool FailedAssignments::covers(const Grid& grid) const {
+    std::lock_guard<std::mutex> lock(m);
+    for (int max_row = -1; max_row < SIZE; ++max_row) {
+        const auto& failed = keys[max_row + 1];
+        if (!failed.empty() && failed.count(pack_regions(grid, regions_through(max_row + 2)))) return true;
+    }
+    return false;
+}
+
+void FailedAssignments::add(const Grid& grid, int max_row) {
+    std::lock_guard<std::mutex> lock(m);
+    keys[max_row + 1].insert(pack_regions(grid, regions_through(max_row + 2)));
+}
@@ -0,0 +1,45 @@
+#include "patterns.hpp"
+
+// Append every legal layout of row's cells [col, SIZE) to out, given the tiles placed so far
+static void enumerate_patterns(int row, int col, RowTiles& tiles, std::vector<RowTiles>& out) {
+    if (col == SIZE) {
+        out.push_back(tiles);
+        return;
+    }
+
+    // Option 1: no tile
+    enumerate_patterns(row, col + 1, tiles, out);
+
+    // Option 2: tile (if allowed)
+    if (Grid::highlight(row, col)) return;
+    if (col == 1 || col == SIZE - 2) return;
+    if (col > 1 && (tiles.mask >> (col - 2) & 3)) return;
+
+    tiles.mask |= uint16_t(1 << col);
+    tiles.cols[tiles.count++] = col;
+    enumerate_patterns(row, col + 1, tiles, out);
+    --tiles.count;
+    tiles.mask &= uint16_t(~(1 << col));
+}
+
+TilePatterns::TilePatterns() {
+    for (int row = 0; row < SIZE; ++row) {
+        RowTiles empty;
+        enumerate_patterns(row, 0, empty, patterns[row]);
+        index[row].fill(-1);
+        for (int i = 0; i < int(patterns[row].size()); ++i) index[row][patterns[row][i].mask] = int16_t(i);
+    }
+
+    compatible[0].resize(1);
+    for (int i = 0; i < int(patterns[0].size()); ++i) compatible[0][0].push_back(uint16_t(i));
+    for (int row = 1; row < SIZE; ++row) {
+        compatible[row].resize(patterns[row - 1].size());
+        for (int above = 0; above < int(patterns[row - 1].size()); ++above) {
+            for (int i = 0; i < int(patterns[row].size()); ++i) {
+                if ((patterns[row - 1][above].mask & patterns[row][i].mask) == 0) compatible[row][above].push_back(uint16_t(i));
+            }
+        }
+    }
+}
+
+const TilePatterns tile_patterns;
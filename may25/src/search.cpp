@@ -0,0 +1,520 @@
+#include "search.hpp"
+#include "clues.hpp"
+#include "domains.hpp"
+#include <memory>
+#include <thread>
+#include <deque>
+#include <condition_variable>
+
+// Memoization table of row pairs known to fail, kept across region assignments (one per worker thread)
+thread_local RowPairMemo* incompatible_pairs = nullptr;
+
+// Set once any worker has found the solution; every running tile() search then unwinds
+std::atomic<bool> cancelled{false};
+
+// Node budgets per region assignment, and the assignments waiting for a restart round
+ScheduleOptions schedule;
+AbandonedAssignments abandoned;
+
+// Whether search threads record telemetry (--telemetry, in builds with NUMBERCROSS_TELEMETRY=1)
+bool record_telemetry = false;
+
+// Distribution of one tile's digit over its valid adjacent cells: cell i may take any amount that
+// keeps it within limit[i], and the last cell leads on to the next tile of the row
+struct TileDistribution {
+    Grid& grid;
+    const RowTiles& tiles;
+    int row;
+    int& max_row;
+    UsedNumbers& used_numbers;
+    int index;
+    NodeBudget& budget;
+    int tile_col, above, valid_count;
+    const std::array<int, 4>& valid_adjacent;
+    const std::array<int, 4>& limit;
+    const std::array<int, 5>& capacity; // capacity[i]: the most that cells i.. can still absorb
+
+    bool operator()(int i, int remaining) {
+        ScopedProbe probe(Probe::Distribute);
+        if (remaining > capacity[i]) { // the rest cannot take it all
+            count_prune(Prune::Capacity, row);
+            return false;
+        }
+
+        if (i == valid_count) {
+            if (remaining != 0) return false; // Remaining not fully distributed
+
+            // Check partial row validity
+            if (row > 0 && !validate_row_left(grid, used_numbers, row - 1, tile_col)) {
+                count_prune(Prune::ValidateRowLeft, row - 1);
+                return false;
+            }
+
+            // Recurse to next tile
+            return increment(grid, tiles, row, max_row, used_numbers, index + 1, budget);
+        }
+
+        uint8_t& digit = grid.digits[valid_adjacent[i]];
+        int original = digit; // store original digit for backtracking
+
+        for (int val = 0; val <= remaining && val + original <= limit[i]; ++val) {
+            if (valid_adjacent[i] == above && !digit_domains.allows(above, original + val)) { // final digit
+                count_prune(Prune::Domain, row - 1);
+                continue;
+            }
+            digit = uint8_t(original + val);
+            if ((*this)(i + 1, remaining - val)) return true; // recurse 
+            digit = uint8_t(original); // backtrack
+        }
+        return false;
+    }
+};
+
+// Try incrementing the row given tile placement
+bool increment(Grid& grid, const RowTiles& tiles, int row, int& max_row, UsedNumbers& used_numbers, int index, NodeBudget& budget) {
+    ScopedProbe probe(Probe::Increment);
+    // Finished incrementing all tiles in this row
+    
+    // If recursion depth is too deep, it is unlikely that this grid generates a solution. Stop recursion. 
+    if (budget.exhausted() || cancelled.load(std::memory_order_relaxed)) {
+        return false; 
+    }
+
+    // The row above is final wherever this row has no tile under it: its digits must be in their domain
+    if (index == 0 && row > 0) {
+        for (int c = 0; c < SIZE; ++c) {
+            const int above = (row - 1) * SIZE + c;
+            if (!grid.tile(row - 1, c) && !grid.tile(row, c) && !digit_domains.allows(above, grid.digits[above])) {
+                count_prune(Prune::Domain, row - 1);
+                return false;
+            }
+        }
+    }
+
+    // All tiles incremeted
+    if (index == tiles.count) {
+
+        if (row == 0) { // no previous row
+            return tile(grid, row + 1, max_row, used_numbers, budget);
+        }
+
+        else if (validate_row(grid, used_numbers, row - 1)){ // if row > 0, check validity of previous row 
+            if (row - 1 > max_row) max_row = row - 1; // maximum valid row 
+            // print_grid(grid);
+            ++budget.used;
+            count_node();
+
+            RowNumbers nums = extract_numbers(grid, row - 1); // extract numbers from previous row
+            size_t mark = used_numbers.mark();
+            for (auto num : nums) used_numbers.insert(num); // insert numbers from valid previous row 
+
+            if (row < 10){ // check with memoization if row < 10 
+                RowPairKey key = row_pair_key(grid, row);
+                const bool known = incompatible_pairs->contains(key, max_row);
+                count_memo(known);
+                if (known) {
+                    count_prune(Prune::Memo, row);
+                    used_numbers.rollback(mark);
+                    return false; // Known to fail
+                }
+                
+                // recurse, tracking the deepest row reached below this pair for the memo entry and
+                // whether any number was rejected as a duplicate of a row above it
+                const int outer_max_row = max_row;
+                const size_t outer_conflict = used_numbers.take_conflict();
+                max_row = row - 1;
+                bool result = tile(grid, row + 1, max_row, used_numbers, budget);
+                const int deepest = max_row;
+                const bool depends_on_above = used_numbers.lowest_conflict() < used_numbers.mark();
+                if (outer_max_row > max_row) max_row = outer_max_row;
+                used_numbers.restore_conflict(outer_conflict);
+                // Cache failure, unless the search was cut short or the rows above took part in it
+                if (!result && !depends_on_above && !budget.exhausted() && !cancelled.load(std::memory_order_relaxed))
+                    incompatible_pairs->insert(key, deepest);
+                used_numbers.rollback(mark); // backtrack
+                return result;
+            }
+
+            else { // if row == 10, can't memoize
+                bool result = tile(grid, row + 1, max_row, used_numbers, budget); // recurse
+                used_numbers.rollback(mark); // backtrack
+                return result; 
+            }
+        }
+        count_prune(Prune::ValidateRow, row - 1);
+        return false;
+    }
+
+    const int tile_col = tiles.cols[index];
+
+    // Collect valid adjacent cells for distribution, with the largest digit each may reach: cells in this
+    // row and the row above are digits of numbers, so they must stay within their domain (the cell above
+    // is final once this tile is done), while cells in the row below may still become tiles
+    const Neighbours& neighbours = ADJACENT[row * SIZE + tile_col];
+    std::array<int, 4> valid_adjacent, limit;
+    int valid_count = 0;
+    for (int k = 0; k < neighbours.count; ++k) {
+        const int adj = neighbours.cells[k];
+        if (!grid.tile(adj / SIZE, adj % SIZE) && !Grid::highlight(adj / SIZE, adj % SIZE)) {
+            limit[valid_count] = adj / SIZE > row ? 9 : digit_domains.max_digit[adj];
+            valid_adjacent[valid_count++] = adj;
+        }
+    }
+    const int above = (row - 1) * SIZE + tile_col;
+
+    // capacity[i]: the most that cells i.. can still absorb
+    std::array<int, 5> capacity{};
+    for (int i = valid_count - 1; i >= 0; --i) capacity[i] = capacity[i + 1] + limit[i] - grid.digits[valid_adjacent[i]];
+
+    // Backtracking over the ways to distribute the tile digit, called directly (no allocation)
+    TileDistribution distribute{grid, tiles, row, max_row, used_numbers, index, budget, tile_col, above, valid_count, valid_adjacent, limit, capacity};
+
+    // If there are no valid adjacent cells, just continue to next tile
+    if (valid_count == 0) return increment(grid, tiles, row, max_row, used_numbers, index + 1, budget);
+
+    return distribute(0, grid.digit(row, tile_col));
+}
+
+// Try tile placement: each legal layout of the row, given the tiles in the row above
+bool tile(Grid& grid, int row, int& max_row, UsedNumbers& used_numbers, NodeBudget& budget){
+    ScopedProbe probe(Probe::Tile);
+
+    // If recursion depth is too deep, the grid is likely to be false
+    if (budget.exhausted() || cancelled.load(std::memory_order_relaxed)) {
+        return false; 
+    }
+    
+    // grid is complete
+    if (row > 10) {
+        if (validate_row(grid, used_numbers, 10)) {
+            return true; // solution found (the grid is left filled in)
+        }
+        return false; // last row is invalid
+    } 
+
+    for (uint16_t i : tile_patterns.candidates(grid, row)) {
+        const RowTiles& tiles = tile_patterns.patterns[row][i];
+        grid.tiles[row] = tiles.mask; // set tiles 
+        if (increment(grid, tiles, row, max_row, used_numbers, 0, budget)) return true; // increment the row 
+        if (budget.exhausted() || cancelled.load(std::memory_order_relaxed)) break;
+    }
+
+    grid.tiles[row] = 0; // undo tiles
+    return false;
+}
+
+// Is value allowed for region, given the regions it must differ from and the digit domains?
+bool region_value_allowed(const Grid& grid, int region, int value) {
+    if (!digit_domains.region_digit[region][value]) return false; // some cell of region could never reach its domain
+    for (int dep : region_dependencies[region]) {
+        if (grid.digit(region_coords[dep][0].first, region_coords[dep][0].second) == value) return false;
+    }
+    return true;
+}
+
+void fill_region(Grid& grid, int region, int value) {
+    for (auto c : region_coords[region]) grid.digit(c.first, c.second) = uint8_t(value);
+}
+
+std::array<uint8_t, 9> region_digits(const Grid& grid) {
+    std::array<uint8_t, 9> digits;
+    for (int i = 0; i < 9; ++i) digits[i] = grid.digit(region_coords[i][0].first, region_coords[i][0].second);
+    return digits;
+}
+
+// Run the tile search for a complete region assignment within budget; max_row receives the last valid row
+Outcome search_assignment(Grid& grid, int& max_row, NodeBudget& budget) {
+    max_row = -1;
+    UsedNumbers used_numbers;
+    if (tile(grid, 0, max_row, used_numbers, budget)) return Outcome::Solved;
+    if (cancelled.load(std::memory_order_relaxed)) return Outcome::Cancelled;
+    return budget.exhausted() ? Outcome::Abandoned : Outcome::Refuted;
+}
+
+// search_assignment with a telemetry record of the run
+Outcome try_assignment(Grid& grid, int& max_row, NodeBudget& budget) {
+    if constexpr (TELEMETRY_ENABLED) {
+        if (telemetry) {
+            static const char* names[] = {"solved", "refuted", "abandoned", "cancelled"};
+            const std::array<uint8_t, 9> digits = region_digits(grid);
+            telemetry->begin_assignment();
+            Outcome outcome = search_assignment(grid, max_row, budget);
+            std::string text;
+            for (int i = 0; i < 9; ++i) text += (i ? " " : "") + std::to_string(digits[i]);
+            telemetry->end_assignment(text, names[int(outcome)], max_row);
+            return outcome;
+        }
+    }
+    return search_assignment(grid, max_row, budget);
+}
+
+// Output a failed digit assignment and the share of its budget it used
+void print_failed_assignment(const Grid& grid, int max_row, const NodeBudget& budget) {
+    std::cout << "Grid assignment: ";
+    for (int i = 0; i < 9; ++i) std::cout<< int(grid.digit(region_coords[i][0].first, region_coords[i][0].second)) << " "; 
+    std::cout << " - Grid didn't work, last max row was " << max_row << " (" << budget.used;
+    if (budget.limit != UNLIMITED) std::cout << " of " << budget.limit;
+    std::cout << (budget.exhausted() ? " nodes, abandoned)\n" : " nodes)\n");
+}
+
+// Find original digit assignment to regions
+bool find_digits(Grid& grid, int region, Grid& last_grid, int& last_max_row){
+
+    if (region > 8) { // region digit assignment complete
+
+        // check if digits of rows 0 to last_max_row + 2 are same as that of the last grid- if so, grid is known to fail 
+        bool no_change = !schedule.complete; 
+        for (int i = 0; i <= last_max_row + 2 && no_change; ++i){
+            if (i > 10) break;
+            if (extract_numbers(last_grid, i).size() == 0) { last_grid = grid; continue; } 
+            if (extract_numbers(last_grid, i)[0] != extract_numbers(grid, i)[0]){ no_change = false; break; } 
+        }
+
+        if (no_change) return false; // known to fail 
+
+        int max_row;
+        NodeBudget budget(schedule.first_budget());
+        Outcome outcome = try_assignment(grid, max_row, budget);
+        if (outcome == Outcome::Solved) {
+            return true;
+        }
+
+        else {
+            // an abandoned assignment waiting for a restart is not known to fail
+            if (outcome == Outcome::Abandoned && schedule.restarts) abandoned.add(region_digits(grid));
+            else { last_grid = grid; last_max_row = max_row; }
+            print_failed_assignment(grid, max_row, budget); // output the failed digit assignment 
+            return false;
+        }
+    }
+
+    // if region is already filled 
+    if (grid.digit(region_coords[region][0].first, region_coords[region][0].second) != 0) {
+        return find_digits(grid, region + 1, last_grid, last_max_row);
+    }
+
+
+    for (int value = 1; value < 10; ++value) { 
+        if (region_value_allowed(grid, region, value)) { // if value is valid, fill the region with value and proceed to next region
+            fill_region(grid, region, value); 
+            if (find_digits(grid, region + 1, last_grid, last_max_row)) return true;
+        }
+    } 
+
+    fill_region(grid, region, 0); // backtrack
+    return false;
+}
+
+// --------------------------------------------------------------------------------------------------------//
+// Parallel search over region assignments
+
+// Digits of regions 0..depth-1; the remaining regions are still open
+struct AssignmentTask {
+    std::array<uint8_t, 9> digits{};
+    int depth = 0;
+};
+
+// Task deque owned by one worker: the owner pushes and pops at the back (depth first),
+// idle workers steal the oldest, largest subtrees from the front
+class TaskDeque {
+public:
+    void push(const AssignmentTask& task) {
+        std::lock_guard<std::mutex> lock(m);
+        tasks.push_back(task);
+    }
+
+    bool pop(AssignmentTask& task) {
+        std::lock_guard<std::mutex> lock(m);
+        if (tasks.empty()) return false;
+        task = tasks.back();
+        tasks.pop_back();
+        return true;
+    }
+
+    bool steal(AssignmentTask& task) {
+        std::lock_guard<std::mutex> lock(m);
+        if (tasks.empty()) return false;
+        task = tasks.front();
+        tasks.pop_front();
+        return true;
+    }
+
+private:
+    std::mutex m;
+    std::deque<AssignmentTask> tasks;
+};
+
+// State shared by the workers of one parallel run
+struct ParallelSearch {
+    FailedAssignments failed;  // replaces the serial last_grid / last_max_row test
+    std::mutex output_mutex;   // one line of output at a time
+    Grid solution;
+    bool found = false;
+
+    // Keep the first solution and cancel every other search
+    void report_solution(const Grid& grid) {
+        std::lock_guard<std::mutex> lock(output_mutex);
+        if (found) return;
+        found = true;
+        solution = grid;
+        cancelled = true;
+    }
+};
+
+// Serial search below a task: assign regions from region on, skipping assignments already covered
+// by a failure in any worker
+bool find_digits_worker(Grid& grid, int region, ParallelSearch& search) {
+    if (cancelled.load(std::memory_order_relaxed)) return false;
+
+    if (region > 8) {
+        if (!schedule.complete && search.failed.covers(grid)) return false; // known to fail
+
+        int max_row;
+        NodeBudget budget(schedule.first_budget());
+        Outcome outcome = try_assignment(grid, max_row, budget);
+        if (outcome == Outcome::Solved) {
+            search.report_solution(grid);
+            return true;
+        }
+        if (outcome == Outcome::Cancelled) return false; // cut short, not a real failure
+
+        if (outcome == Outcome::Abandoned && schedule.restarts) abandoned.add(region_digits(grid));
+        else search.failed.add(grid, max_row);
+        std::lock_guard<std::mutex> lock(search.output_mutex);
+        print_failed_assignment(grid, max_row, budget);
+        return false;
+    }
+
+    for (int value = 1; value < 10; ++value) {
+        if (region_value_allowed(grid, region, value)) {
+            fill_region(grid, region, value);
+            if (find_digits_worker(grid, region + 1, search)) return true;
+        }
+    }
+    fill_region(grid, region, 0); // backtrack
+    return false;
+}
+
+// Region assignments split across `workers` threads, each with its own grid, used numbers and row
+// pair memo (memo_mb / workers megabytes each). Tasks fix the digits of the first split_depth
+// regions; a worker expands a shallower task into its children on its own deque and idle workers
+// steal from the others, or sleep until there is something to steal. The first solution cancels
+// every search still running; on success grid holds the solved grid.
+bool find_digits_parallel(Grid& grid, int workers, size_t memo_mb, int split_depth) {
+    std::vector<TaskDeque> deques(workers);
+    std::atomic<int> pending{1}; // tasks pushed but not yet finished
+    std::atomic<int> queued{1};  // tasks pushed but not yet taken
+    ParallelSearch search;
+
+    // Idle workers wait here for new tasks, the last task to finish, or a solution
+    std::mutex idle_mutex;
+    std::condition_variable idle;
+    auto wake_idle = [&]() {
+        std::lock_guard<std::mutex> lock(idle_mutex);
+        idle.notify_all();
+    };
+
+    deques[0].push(AssignmentTask{});
+
+    auto worker = [&](int id) {
+        RowPairMemo memo(std::max<size_t>(1, memo_mb / workers));
+        incompatible_pairs = &memo;
+        TelemetryScope recording(record_telemetry, id);
+        AssignmentTask task;
+        Grid local;
+
+        while (!cancelled.load(std::memory_order_relaxed)) {
+            // Take our own newest task, otherwise steal from the other workers in turn
+            bool have_task = deques[id].pop(task);
+            for (int i = 1; i < workers && !have_task; ++i) have_task = deques[(id + i) % workers].steal(task);
+            if (!have_task) {
+                std::unique_lock<std::mutex> lock(idle_mutex);
+                idle.wait(lock, [&]() { return queued.load() > 0 || pending.load() == 0 || cancelled.load(); });
+                if (pending.load() == 0) break;
+                continue;
+            }
+            --queued;
+
+            local = Grid{};
+            for (int region = 0; region < task.depth; ++region) fill_region(local, region, task.digits[region]);
+
+            if (task.depth < split_depth) {
+                // Push in reverse so that our own pops try values in the same order as the serial search
+                for (int value = 9; value >= 1; --value) {
+                    if (!region_value_allowed(local, task.depth, value)) continue;
+                    AssignmentTask child = task;
+                    child.digits[child.depth++] = uint8_t(value);
+                    ++pending;
+                    ++queued;
+                    deques[id].push(child);
+                }
+                wake_idle();
+            }
+            else find_digits_worker(local, task.depth, search);
+            if (--pending == 0 || cancelled.load()) wake_idle();
+        }
+        incompatible_pairs = nullptr;
+    };
+
+    std::vector<std::thread> pool;
+    for (int i = 0; i < workers; ++i) pool.emplace_back(worker, i);
+    for (auto& t : pool) t.join();
+
+    if (!search.found) return false;
+    grid = search.solution;
+    return true;
+}
+
+// Restart rounds: revisit the abandoned assignments with escalating budgets until each is solved or
+// refuted, on `workers` threads (each with its own row pair memo, unless the calling thread already
+// has one). On success grid holds the solved grid.
+bool restart_abandoned(Grid& grid, int workers, size_t memo_mb) {
+    int64_t tried = schedule.first_budget();
+    for (int64_t round = 2; !abandoned.empty(); ++round) {
+        const int64_t limit = schedule.round_budget(round);
+        if (limit <= tried) continue; // the same search as before
+        tried = limit;
+
+        const std::vector<std::array<uint8_t, 9>> pending = abandoned.take();
+        std::cout << "Restart round " << round << ": " << pending.size() << " abandoned assignments, budget " << limit << " nodes\n";
+
+        std::atomic<size_t> next{0};
+        std::atomic<int> ids{0};
+        ParallelSearch search;
+        auto worker = [&]() {
+            TelemetryScope recording(record_telemetry && !telemetry, ids++);
+            std::unique_ptr<RowPairMemo> memo;
+            if (!incompatible_pairs) {
+                memo = std::make_unique<RowPairMemo>(std::max<size_t>(1, memo_mb / workers));
+                incompatible_pairs = memo.get();
+            }
+            for (size_t i = next++; i < pending.size() && !cancelled.load(std::memory_order_relaxed); i = next++) {
+                Grid local;
+                for (int region = 0; region < 9; ++region) fill_region(local, region, pending[i][region]);
+                int max_row;
+                NodeBudget budget(limit);
+                Outcome outcome = try_assignment(local, max_row, budget);
+                if (outcome == Outcome::Solved) search.report_solution(local);
+                if (outcome == Outcome::Solved || outcome == Outcome::Cancelled) break;
+
+                if (outcome == Outcome::Abandoned) abandoned.add(pending[i]);
+                std::lock_guard<std::mutex> lock(search.output_mutex);
+                print_failed_assignment(local, max_row, budget);
+            }
+            if (memo) incompatible_pairs = nullptr;
+        };
+
+        if (workers == 1) worker();
+        else {
+            std::vector<std::thread> pool;
+            for (int i = 0; i < workers; ++i) pool.emplace_back(worker);
+            for (auto& t : pool) t.join();
+        }
+
+        if (search.found) {
+            grid = search.solution;
+            return true;
+        }
+    }
+    return false;
+}
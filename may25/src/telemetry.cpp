@@ -0,0 +1,77 @@
+#include "telemetry.hpp"
+#include <cstdio>
+#include <mutex>
+
+thread_local Telemetry* telemetry = nullptr;
+
+static std::mutex output_mutex; // one JSON line at a time
+
+static double seconds_since(std::chrono::steady_clock::time_point since) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - since).count();
+}
+
+static const char* probe_name(int p) {
+    static const char* names[] = {"tile", "increment", "distribute", "validate_row", "validate_row_left"};
+    return names[p];
+}
+
+static const char* prune_name(int p) {
+    static const char* names[] = {"validate_row", "validate_row_left", "memo", "domain", "capacity"};
+    return names[p];
+}
+
+Telemetry::Telemetry(int worker) : worker(worker) {
+    start = assignment_start = last_report = std::chrono::steady_clock::now();
+}
+
+void Telemetry::begin_assignment() {
+    calls.fill(0);
+    nanos.fill(0);
+    for (auto& row : prunes) row.fill(0);
+    memo_hits = memo_misses = 0;
+    nodes = 0;
+    child_nanos = 0;
+    assignment_start = std::chrono::steady_clock::now();
+}
+
+void Telemetry::end_assignment(const std::string& digits, const char* outcome, int max_row) {
+    const double seconds = seconds_since(assignment_start);
+    std::string out = "{\"type\":\"assignment\",\"worker\":" + std::to_string(worker) + ",\"digits\":\"" + digits +
+                      "\",\"outcome\":\"" + outcome + "\",\"max_row\":" + std::to_string(max_row) +
+                      ",\"nodes\":" + std::to_string(nodes) + ",\"seconds\":" + std::to_string(seconds);
+
+    out += ",\"calls\":{";
+    for (int p = 0; p < int(Probe::Count); ++p) out += (p ? ",\"" : "\"") + std::string(probe_name(p)) + "\":" + std::to_string(calls[p]);
+    out += "},\"ms\":{";
+    for (int p = 0; p < int(Probe::Count); ++p) out += (p ? ",\"" : "\"") + std::string(probe_name(p)) + "\":" + std::to_string(double(nanos[p]) / 1e6);
+
+    const uint64_t lookups = memo_hits + memo_misses;
+    out += "},\"memo\":{\"hits\":" + std::to_string(memo_hits) + ",\"misses\":" + std::to_string(memo_misses) +
+           ",\"hit_rate\":" + std::to_string(lookups ? double(memo_hits) / double(lookups) : 0.0) + "}";
+
+    out += ",\"prunes\":{";
+    for (int p = 0; p < int(Prune::Count); ++p) {
+        out += (p ? ",\"" : "\"") + std::string(prune_name(p)) + "\":[";
+        for (int r = 0; r < SIZE; ++r) out += (r ? "," : "") + std::to_string(prunes[p][r]);
+        out += "]";
+    }
+    out += "}}\n";
+
+    std::lock_guard<std::mutex> lock(output_mutex);
+    std::fputs(out.c_str(), stderr);
+}
+
+void Telemetry::heartbeat() {
+    if (report_every <= 0) return;
+    const double since = seconds_since(last_report);
+    if (since < report_every) return;
+    std::string out = "{\"type\":\"heartbeat\",\"worker\":" + std::to_string(worker) +
+                      ",\"seconds\":" + std::to_string(seconds_since(start)) + ",\"calls\":" + std::to_string(ticks) +
+                      ",\"nodes\":" + std::to_string(total_nodes) +
+                      ",\"nodes_per_sec\":" + std::to_string(uint64_t(double(total_nodes - last_nodes) / since)) + "}\n";
+    last_report = std::chrono::steady_clock::now();
+    last_nodes = total_nodes;
+
+    std::lock_guard<std::mutex> lock(output_mutex);
+    std::fputs(out.c_str(), stderr);
+}